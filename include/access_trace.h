@@ -0,0 +1,65 @@
+#pragma once
+
+// Generated by tools/gen_access_trace.py from data/access_sample.log, do not edit.
+// Regenerate: python3 tools/gen_access_trace.py data/access_sample.log include/access_trace.h
+// (pio run does it before each build), compare only: add --check.
+
+#include <stdint.h>
+
+#define ACCESS_TRACE_PATHS 18
+#define ACCESS_TRACE_LENGTH 700
+#define ACCESS_TRACE_PATH_BYTES 251 // Sum of the path lengths
+
+inline constexpr const char *accessTracePaths[ACCESS_TRACE_PATHS] = {
+    "/events",
+    "/api/log.txt",
+    "/api/status.json",
+    "/api/sensors.json",
+    "/index.html",
+    "/css/style.css",
+    "/js/main.js",
+    "/js/vendor.min.js",
+    "/img/logo.webp",
+    "/img/hero.webp",
+    "/fonts/inter.woff2",
+    "/favicon.ico",
+    "/manifest.json",
+    "/img/chart.svg",
+    "/settings.html",
+    "/js/settings.js",
+    "/api/config.json",
+    "/js/main.js.map",
+};
+
+inline constexpr uint8_t accessTraceSequence[ACCESS_TRACE_LENGTH] = {
+    0, 1, 2, 3, 2, 2, 2, 2, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 2, 2, 2, 3, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 3, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 3, 2, 2, 3, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 3, 2, 2, 2,
+    2, 2, 3, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 3, 2, 4, 5,
+    6, 7, 8, 9, 10, 11, 12, 13, 2, 2, 2, 3, 2, 2, 2, 2, 3, 2, 2, 2, 3, 2, 3, 2,
+    2, 3, 2, 3, 2, 2, 3, 2, 3, 2, 3, 2, 3, 2, 2, 2, 2, 2, 2, 2, 2, 2, 3, 2,
+    3, 2, 2, 3, 2, 3, 2, 2, 2, 2, 3, 2, 2, 2, 2, 3, 14, 5, 6, 15, 8, 16, 2, 2,
+    3, 2, 2, 2, 3, 2, 2, 3, 2, 3, 2, 2, 3, 2, 2, 2, 2, 2, 2, 3, 2, 2, 2, 2,
+    2, 2, 2, 3, 2, 2, 3, 2, 2, 3, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    3, 2, 2, 2, 2, 2, 2, 2, 2, 2, 3, 2, 3, 2, 2, 2, 3, 2, 2, 2, 2, 3, 2, 2,
+    2, 2, 2, 2, 2, 3, 2, 3, 2, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 17, 13, 2, 2,
+    2, 3, 2, 2, 3, 2, 2, 3, 2, 2, 3, 2, 2, 2, 2, 2, 2, 2, 2, 2, 3, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 4, 5, 6, 7, 8, 9, 10, 11, 12, 2, 2, 2, 2, 3, 2, 2, 2, 2,
+    2, 2, 3, 2, 2, 2, 3, 2, 2, 2, 2, 2, 3, 2, 2, 2, 4, 5, 6, 7, 8, 9, 10, 11,
+    12, 17, 13, 14, 5, 6, 15, 8, 16, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 3, 2, 3,
+    2, 3, 2, 2, 2, 2, 2, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 3, 2, 2, 2, 2, 3, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 3,
+    2, 2, 2, 2, 2, 2, 3, 2, 2, 2, 2, 2, 2, 2, 3, 2, 2, 3, 2, 3, 2, 2, 3, 2,
+    2, 2, 2, 2, 3, 2, 14, 5, 6, 15, 8, 16, 4, 5, 6, 7, 8, 9, 10, 11, 12, 17, 2, 2,
+    2, 2, 2, 2, 2, 3, 2, 14, 5, 6, 15, 8, 16, 2, 2, 2, 2, 2, 2, 2, 2, 3, 2, 2,
+    2, 2, 2, 4, 5, 6, 7, 8, 9, 10, 11, 12, 14, 5, 6, 15, 8, 16, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 3, 2, 2, 2, 2, 2, 4, 5, 6, 7, 8, 9,
+    10, 11, 12, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 3, 2, 2, 3, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 3, 2, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 2, 2, 3,
+    2, 2, 2, 3, 2, 2, 2, 2, 2, 2, 3, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 3, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 0, 1, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 3, 2, 2, 2, 2, 2, 2, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13,
+    4, 5, 6, 7, 8, 9, 10, 11, 12, 2, 2, 2, 2, 2, 3, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 3, 2, 2, 2, 3, 2, 2, 2, 2, 2, 3, 2, 2,
+    2, 2, 2, 2,
+};
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <Arduino.h>
+#include "mime_types.h"
+
+// ========================================
+// ADAPTIVE RESOLVER (Version 6)
+// ========================================
+//
+// Probes mimeTable in an order learned from the traffic it sees: every
+// ADAPTIVE_REORDER_INTERVAL calls the probe order is re-sorted by hit count
+// and the counters are halved, so the order follows shifting workloads.
+// Not thread safe: call it from one task only.
+
+#define ADAPTIVE_REORDER_INTERVAL 256 // Calls between two reorders
+
+struct AdaptiveResolverStats
+{
+  uint32_t calls;                      // Calls since the last reset
+  uint32_t misses;                     // Calls resolved to application/octet-stream
+  uint32_t reorders;                   // Probe order updates since the last reset
+  uint32_t probes;                     // Table entries compared since the last reset
+  uint32_t hits[MIME_TABLE_SIZE];      // Decayed hit count per mimeTable entry
+  uint8_t order[MIME_TABLE_SIZE];      // Current probe order (mimeTable indices)
+};
+
+void _setContentTypeFromPath_v6(const String &path);
+
+/**
+ * @brief Back to mimeTable order with all counters cleared
+ */
+void resetAdaptiveResolver();
+
+const AdaptiveResolverStats &adaptiveResolverStats();
+
+/**
+ * @brief Print probe order, decayed hit counts and average probes per call
+ */
+void printAdaptiveResolverStats();
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <Arduino.h>
+
+// ========================================
+// BENCHMARK ENGINE
+// ========================================
+//
+// Runs warmup + measured rounds of a candidate, rejects outlier rounds and
+// summarizes the rest with median, MAD and a bootstrap confidence interval.
+// Two candidates are only ranked when the bootstrap interval of the
+// difference of their medians excludes zero.
+
+#define BENCH_MAX_ROUNDS 32            // Upper bound for BenchConfig::rounds
+#define BENCH_MAX_BOOTSTRAP 1000       // Upper bound for BenchConfig::bootstrapResamples
+
+struct BenchConfig
+{
+  int warmupRounds;            // Rounds executed and discarded before measuring
+  int rounds;                  // Measured rounds (<= BENCH_MAX_ROUNDS)
+  int bootstrapResamples;      // Resamples for confidence intervals (<= BENCH_MAX_BOOTSTRAP)
+  double confidence;           // Confidence level of the intervals, e.g. 0.95
+  double outlierThreshold;     // Rounds further than this many scaled MADs from the median are rejected
+  const char *unit;            // Unit of the samples, for printing
+};
+
+struct BenchResult
+{
+  const char *name;
+  int samples;                 // Rounds kept after outlier rejection
+  int outliers;                // Rounds rejected
+  double values[BENCH_MAX_ROUNDS]; // Kept rounds
+  double median;
+  double mad;                  // Median absolute deviation, unscaled
+  double mean;
+  double ciLow;                // Bootstrap confidence interval of the median
+  double ciHigh;
+};
+
+/**
+ * @brief Executes one measured round and returns its sample (e.g. μs per call)
+ */
+typedef double (*BenchRoundFn)(void *context);
+
+/**
+ * @brief Warm up, measure and summarize one candidate
+ * @param verbose Print every measured round
+ */
+void benchRun(const char *name, BenchRoundFn round, void *context, const BenchConfig &config,
+              BenchResult &result, bool verbose = true);
+
+/**
+ * @brief Cost of a relative to b from interleaved rounds
+ * @param ratio Summary of the per-round ratios a / b: 1.02 means a costs 2% more
+ * @note a and b alternate round by round (and which goes first), so drift,
+ *       interrupts and frequency changes hit both alike. Far tighter than
+ *       comparing two separate benchRun() medians.
+ */
+void benchPaired(const char *name, BenchRoundFn a, void *contextA, BenchRoundFn b, void *contextB,
+                 const BenchConfig &config, BenchResult &ratio);
+
+/**
+ * @brief Outlier rejection + statistics over already collected samples
+ */
+void benchSummarize(const char *name, const double *samples, int count, const BenchConfig &config,
+                    BenchResult &result);
+
+/**
+ * @brief Bootstrap confidence interval of median(a) - median(b)
+ * @return true when the interval contains zero (statistically indistinguishable)
+ */
+bool benchIndistinguishable(const BenchResult &a, const BenchResult &b, const BenchConfig &config,
+                            double *diffLow = nullptr, double *diffHigh = nullptr);
+
+/**
+ * @brief Index of the candidate with the lowest median
+ */
+int benchFastest(const BenchResult results[], int count);
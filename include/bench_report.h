@@ -0,0 +1,44 @@
+#pragma once
+
+#include <Arduino.h>
+
+// ========================================
+// MACHINE-READABLE RESULTS
+// ========================================
+//
+// Every result is also printed as one JSON object per line, prefixed with
+// BENCH_RECORD_PREFIX, next to the human readable output. Device and host
+// builds emit the same format, so tools/bench_compare.py can pick the
+// records out of a serial capture or a native run and compare them with a
+// stored baseline. Build with -DBENCH_RECORDS=0 to silence them.
+
+#ifndef BENCH_RECORDS
+#define BENCH_RECORDS 1
+#endif
+
+#define BENCH_RECORD_PREFIX "BENCH "
+
+/**
+ * @brief Print one result record
+ * @param suite Benchmark the value comes from, e.g. "lookup" or "latency"
+ * @param resolver Resolver name, "" when not resolver specific
+ * @param path Test path, "*" for a value over all paths
+ * @param metric e.g. "median", "p99", "stack_bytes"
+ * @param iterations Calls behind the value, 0 when not applicable
+ * @note CPU frequency, chip revision and build flags are added to every record
+ */
+void benchRecord(const char *suite, const char *resolver, const char *path, const char *metric, double value,
+                 const char *unit, long iterations = 0);
+
+/**
+ * @brief A guarantee the run must meet: prints ✅ or ❌ and records it as a "check" result (failed = 1)
+ * @return condition
+ * @note A failed check makes the host program exit with status 1. The
+ *       benchmark goes on, so the rest of the report is still produced.
+ */
+bool benchRequire(bool condition, const char *check);
+
+/**
+ * @brief Failed benchRequire() checks so far
+ */
+int benchFailedChecks();
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <Arduino.h>
+
+#if defined(__XTENSA__)
+#include <xtensa/hal.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <time.h>
+#endif
+
+// ========================================
+// CYCLE COUNTER
+// ========================================
+//
+// ESP32: Xtensa CCOUNT register (one tick per CPU cycle).
+// x86 host: time stamp counter. Other hosts: CLOCK_MONOTONIC nanoseconds.
+// Only differences of two readings are meaningful, they wrap at 32 bits.
+
+/**
+ * @brief Read the free running cycle counter
+ */
+static inline uint32_t readCycles()
+{
+  uint32_t cycles;
+  asm volatile("" ::: "memory");
+#if defined(__XTENSA__)
+  cycles = xthal_get_ccount();
+#elif defined(__x86_64__) || defined(__i386__)
+  cycles = (uint32_t)__rdtsc();
+#else
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  cycles = (uint32_t)((uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec);
+#endif
+  asm volatile("" ::: "memory");
+  return cycles;
+}
+
+/**
+ * @brief Counter ticks per microsecond
+ * @note On the host the TSC rate is calibrated once, by the ArduinoNative shim
+ */
+static inline uint32_t cyclesPerMicrosecond()
+{
+#if defined(__XTENSA__)
+  return getCpuFrequencyMhz();
+#elif defined(BENCH_NATIVE)
+  return hostCounterTicksPerMicro();
+#else
+  return 1000;
+#endif
+}
+
+/**
+ * @brief Cost of two back-to-back readCycles(), subtracted from each sample
+ */
+static inline uint32_t readCyclesOverhead()
+{
+  uint32_t best = UINT32_MAX;
+  for (int i = 0; i < 1000; i++)
+  {
+    uint32_t start = readCycles();
+    uint32_t cycles = readCycles() - start;
+    best = cycles < best ? cycles : best;
+  }
+  return best;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <Arduino.h>
+#include "mime_types.h"
+#include "resolver_registry.h"
+
+// ========================================
+// DIFFERENTIAL VERIFICATION
+// ========================================
+//
+// Every registered resolver is run on each path and compared with a
+// straightforward reference (strrchr + strcmp over mimeTable). Resolvers
+// flagged RESOLVER_EXTENDED_SEMANTICS are compared with the case-insensitive,
+// .gz/.br aware reference instead, encoding included. _contentType is set to
+// a stale marker before every call, so a resolver that forgets to write it
+// is caught even when the previous result happened to be right.
+
+#define DIFF_MAX_PATH 256     // Longer inputs are truncated
+#define DIFF_REPORT_LIMIT 10  // Mismatches printed in full, the rest are only counted
+
+#if defined(BENCH_NATIVE)
+#define DIFF_SWEEP_MAX_LEN 6  // Extension characters covered by the exhaustive sweep
+#else
+#define DIFF_SWEEP_MAX_LEN 4  // 5 and 6 would take minutes at 240 MHz
+#endif
+
+struct DifferentialStats
+{
+  uint32_t paths;
+  uint32_t mismatches;
+  uint32_t perResolver[RESOLVER_REGISTRY_MAX]; // Mismatches of resolverAt(i)
+};
+
+/**
+ * @brief Reference MIME type: the text after the last dot, compared with strcmp against mimeTable
+ */
+const char *referenceContentType(const char *path);
+
+/**
+ * @brief Reference of RESOLVER_EXTENDED_SEMANTICS: ASCII case folded, .gz/.br suffix over a known extension
+ */
+const char *referenceContentTypeExtended(const char *path, ContentEncoding &encoding);
+
+/**
+ * @brief Run every resolver on path[0, len) (up to the first NUL) and count disagreements
+ * @return Mismatches on this path
+ */
+int checkResolvers(const char *path, size_t len, DifferentialStats &stats);
+
+/**
+ * @brief Every extension of 1..DIFF_SWEEP_MAX_LEN characters over the per-position alphabets, behind several prefixes
+ * @note Each position takes the characters mimeTable uses there, their upper
+ *       case, and 'z', '.' and '/' as representatives of everything else.
+ *       Every known extension is also tried with .gz/.br style suffixes.
+ */
+void runExhaustiveSweep(DifferentialStats &stats);
+
+/**
+ * @brief count pseudo random paths built from path-like fragments, reproducible from seed
+ */
+void runRandomPaths(uint32_t count, uint32_t seed, DifferentialStats &stats);
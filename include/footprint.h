@@ -0,0 +1,35 @@
+#pragma once
+
+#include <Arduino.h>
+#include "resolver_registry.h"
+
+// ========================================
+// PER-RESOLVER MEMORY FOOTPRINT
+// ========================================
+//
+// Runtime half of the footprint report: stack depth and heap allocations.
+// Code, rodata and static RAM come from the linked ELF, see
+// tools/resolver_footprint.py.
+//
+// Allocations are counted by wrapping malloc/calloc/realloc at link time
+// (-Wl,--wrap=malloc,... in platformio.ini). Without those flags the
+// counter never moves and heapHookActive() reports it.
+
+#define FOOTPRINT_TASK_STACK 8192 // Bytes given to the isolated stack measurement task/thread
+
+/**
+ * @brief Heap allocations (malloc, calloc, realloc) since boot, all tasks together
+ */
+uint32_t heapAllocationCount();
+
+/**
+ * @brief True when the link-time malloc wrappers are in place
+ */
+bool heapHookActive();
+
+/**
+ * @brief Deepest stack use of func over paths, measured in a fresh task (ESP32) or thread (host)
+ * @return Bytes written below the call site, return address and callees included;
+ *         0 when the probe could not run
+ */
+size_t measureStackDepth(ResolverFn func, const String paths[], int pathCount);
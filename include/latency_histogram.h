@@ -0,0 +1,96 @@
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+// ========================================
+// LOG-BUCKETED LATENCY HISTOGRAM
+// ========================================
+
+/**
+ * @brief Fixed-size histogram of per-call cycle counts
+ * @note Values below 8 get one bucket each, above that every power of two is
+ *       split in 8 sub-buckets (12.5% resolution). Samples of 2^20 cycles or
+ *       more share the last bucket. min and max are exact.
+ */
+class LatencyHistogram
+{
+public:
+  static constexpr int SUB_BUCKET_BITS = 3;
+  static constexpr int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+  static constexpr int MAX_MSB = 19;
+  static constexpr int BUCKET_COUNT = (MAX_MSB - SUB_BUCKET_BITS + 2) * SUB_BUCKETS + 1;
+
+  LatencyHistogram() { reset(); }
+
+  void reset()
+  {
+    memset(_buckets, 0, sizeof(_buckets));
+    _count = 0;
+    _min = UINT32_MAX;
+    _max = 0;
+  }
+
+  void record(uint32_t value)
+  {
+    _buckets[bucketOf(value)]++;
+    _count++;
+    _min = value < _min ? value : _min;
+    _max = value > _max ? value : _max;
+  }
+
+  uint32_t count() const { return _count; }
+  uint32_t minValue() const { return _count ? _min : 0; }
+  uint32_t maxValue() const { return _max; }
+
+  /**
+   * @brief Upper bound of the bucket holding the given quantile, clamped to maxValue()
+   * @param quantile 0.0 .. 1.0
+   */
+  uint32_t percentile(double quantile) const
+  {
+    if (!_count)
+      return 0;
+    uint32_t rank = (uint32_t)(quantile * _count + 0.5);
+    rank = rank < 1 ? 1 : (rank > _count ? _count : rank);
+    uint32_t seen = 0;
+    for (int i = 0; i < BUCKET_COUNT; i++)
+    {
+      seen += _buckets[i];
+      if (seen >= rank)
+      {
+        uint32_t upper = bucketUpperBound(i);
+        return upper < _max ? upper : _max;
+      }
+    }
+    return _max;
+  }
+
+private:
+  static int bucketOf(uint32_t value)
+  {
+    if (value < SUB_BUCKETS)
+      return (int)value;
+    int msb = 31 - __builtin_clz(value);
+    if (msb > MAX_MSB)
+      return BUCKET_COUNT - 1;
+    int sub = (int)(value >> (msb - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1);
+    return (msb - SUB_BUCKET_BITS + 1) * SUB_BUCKETS + sub;
+  }
+
+  static uint32_t bucketUpperBound(int bucket)
+  {
+    if (bucket < SUB_BUCKETS)
+      return (uint32_t)bucket;
+    if (bucket == BUCKET_COUNT - 1)
+      return UINT32_MAX;
+    int msb = bucket / SUB_BUCKETS + SUB_BUCKET_BITS - 1;
+    uint32_t sub = (uint32_t)(bucket % SUB_BUCKETS);
+    return ((SUB_BUCKETS + sub + 1) << (msb - SUB_BUCKET_BITS)) - 1;
+  }
+
+  uint32_t _buckets[BUCKET_COUNT];
+  uint32_t _count;
+  uint32_t _min;
+  uint32_t _max;
+};
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "mime_hash.h"
+
+// ========================================
+// BATCHED RESOLUTION
+// ========================================
+//
+// Classifies a whole array of paths in one call, for directory listings
+// and cache manifests. Same result as mimeIndexFor() on each entry.
+
+#define MIME_BATCH_LANES 4 // Paths processed side by side
+
+struct PathView
+{
+  const char *data; // Not necessarily NUL terminated
+  size_t len;
+};
+
+/**
+ * @brief indices[i] = mimeIndexFor(paths[i].data, paths[i].len) for i in [0, count)
+ * @note Branch-free per path: the last 8 bytes are loaded as one word, the
+ *       last dot is found with SWAR byte compares and the extension is
+ *       compared to the hash slot as one 64-bit key. MIME_BATCH_LANES paths
+ *       go through each stage together so their loads overlap.
+ */
+void mimeIndicesFor(const PathView *paths, size_t count, uint8_t *indices);
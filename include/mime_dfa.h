@@ -0,0 +1,115 @@
+#pragma once
+
+#include "mime_hash.h"
+
+// ========================================
+// EXTENSION DFA (generated at compile time)
+// ========================================
+//
+// Byte-level trie over the mimeTable extensions, laid out as a DFA
+// transition table. Bytes are first mapped to a character class (only
+// the characters used by some extension get one) to keep the table
+// small. State 0 is the dead state, state 1 follows the dot. Each byte
+// of the extension is read once, no string compare is left.
+
+#define MIME_DFA_DEAD 0
+#define MIME_DFA_ROOT 1
+#define MIME_DFA_SCRATCH_STATES 128 // Upper bound while counting, > 1 + sum of extension lengths
+#define MIME_DFA_SCRATCH_CLASSES 64 // Upper bound while counting, > distinct extension characters
+
+/**
+ * @brief States and character classes of the trie, class 0 is "any other byte"
+ */
+struct MimeDfaShape
+{
+  size_t states;
+  size_t classes;
+};
+
+static constexpr MimeDfaShape measureMimeDfa()
+{
+  uint8_t charClass[256] = {};
+  uint8_t next[MIME_DFA_SCRATCH_STATES][MIME_DFA_SCRATCH_CLASSES] = {};
+  MimeDfaShape shape = {MIME_DFA_ROOT + 1, 1};
+  for (size_t i = 0; i < MIME_TABLE_SIZE; i++)
+  {
+    size_t state = MIME_DFA_ROOT;
+    for (const char *c = mimeTable[i].ext + 1; *c; c++)
+    {
+      uint8_t &cls = charClass[(uint8_t)*c];
+      if (!cls)
+        cls = (uint8_t)shape.classes++;
+      if (!next[state][cls])
+        next[state][cls] = (uint8_t)shape.states++;
+      state = next[state][cls];
+    }
+  }
+  return shape;
+}
+
+inline constexpr MimeDfaShape MIME_DFA_SHAPE = measureMimeDfa();
+static_assert(MIME_DFA_SHAPE.states < MIME_DFA_SCRATCH_STATES && MIME_DFA_SHAPE.classes < MIME_DFA_SCRATCH_CLASSES,
+              "mimeTable outgrew the DFA scratch bounds");
+
+struct MimeDfa
+{
+  uint8_t charClass[256];
+  uint8_t next[MIME_DFA_SHAPE.states][MIME_DFA_SHAPE.classes];
+  uint8_t accept[MIME_DFA_SHAPE.states]; // mimeTable index, MIME_INDEX_NONE when the state ends no extension
+};
+
+static constexpr MimeDfa buildMimeDfa()
+{
+  MimeDfa dfa = {};
+  size_t states = MIME_DFA_ROOT + 1;
+  size_t classes = 1;
+  for (size_t s = 0; s < MIME_DFA_SHAPE.states; s++)
+    dfa.accept[s] = MIME_INDEX_NONE;
+  for (size_t i = 0; i < MIME_TABLE_SIZE; i++)
+  {
+    size_t state = MIME_DFA_ROOT;
+    for (const char *c = mimeTable[i].ext + 1; *c; c++)
+    {
+      uint8_t &cls = dfa.charClass[(uint8_t)*c];
+      if (!cls)
+        cls = (uint8_t)classes++;
+      if (!dfa.next[state][cls])
+        dfa.next[state][cls] = (uint8_t)states++;
+      state = dfa.next[state][cls];
+    }
+    dfa.accept[state] = (uint8_t)i;
+  }
+  return dfa;
+}
+
+inline constexpr MimeDfa mimeDfa = buildMimeDfa();
+
+/**
+ * @brief mimeTable index of the NUL terminated extension ext (first character after the dot)
+ * @return MIME_INDEX_NONE when unknown
+ */
+static constexpr uint8_t mimeDfaIndex(const char *ext)
+{
+  uint8_t state = MIME_DFA_ROOT;
+  for (; *ext && state != MIME_DFA_DEAD; ext++)
+    state = mimeDfa.next[state][mimeDfa.charClass[(uint8_t)*ext]];
+  return mimeDfa.accept[state];
+}
+
+/**
+ * @brief mimeDfaIndex() over the len bytes at ext, which need not be NUL terminated
+ */
+static constexpr uint8_t mimeDfaIndex(const char *ext, size_t len)
+{
+  uint8_t state = MIME_DFA_ROOT;
+  for (const char *end = ext + len; ext < end && state != MIME_DFA_DEAD; ext++)
+    state = mimeDfa.next[state][mimeDfa.charClass[(uint8_t)*ext]];
+  return mimeDfa.accept[state];
+}
+
+static_assert(mimeDfaIndex("html") == 0 && mimeDfaIndex("htm") == 1, "mimeDfaIndex: prefix of another extension");
+static_assert(mimeDfaIndex("woff2") == mimeIndexFor(".woff2", 6), "mimeDfaIndex: .woff2");
+static_assert(mimeDfaIndex("ht") == MIME_INDEX_NONE, "mimeDfaIndex: inner trie state");
+static_assert(mimeDfaIndex("htmlx") == MIME_INDEX_NONE, "mimeDfaIndex: past a leaf");
+static_assert(mimeDfaIndex("") == MIME_INDEX_NONE, "mimeDfaIndex: empty extension");
+static_assert(mimeDfaIndex("css?v=2", 3) == mimeIndexFor(".css", 4), "mimeDfaIndex: slice of a longer buffer");
@@ -0,0 +1,144 @@
+#pragma once
+
+#include "mime_types.h"
+
+// ========================================
+// PERFECT HASH (generated at compile time)
+// ========================================
+
+#define MIME_HASH_BITS 5
+#define MIME_HASH_SLOTS (1u << MIME_HASH_BITS)
+
+/**
+ * @brief Multiplicative hash over extension length, first and last character
+ * @param first Character after the dot
+ * @param last Last character of the extension
+ * @param len Extension length, dot included
+ */
+static constexpr uint32_t mimeHash(char first, char last, size_t len, uint32_t seed)
+{
+  return (((uint32_t)(uint8_t)first | ((uint32_t)(uint8_t)last << 8) | ((uint32_t)len << 16)) * seed) >> (32 - MIME_HASH_BITS);
+}
+
+/**
+ * @brief True when seed maps every mimeTable extension to its own slot
+ */
+static constexpr bool mimeSeedIsPerfect(uint32_t seed)
+{
+  bool used[MIME_HASH_SLOTS] = {};
+  for (size_t i = 0; i < MIME_TABLE_SIZE; i++)
+  {
+    const char *ext = mimeTable[i].ext;
+    size_t len = constLength(ext);
+    uint32_t slot = mimeHash(ext[1], ext[len - 1], len, seed);
+    if (used[slot])
+      return false;
+    used[slot] = true;
+  }
+  return true;
+}
+
+/**
+ * @brief First collision free seed of the golden ratio sequence, 0 if none
+ */
+static constexpr uint32_t findMimeHashSeed()
+{
+  for (uint32_t i = 1; i < 100000; i++)
+  {
+    if (mimeSeedIsPerfect(i * 0x9E3779B1u))
+      return i * 0x9E3779B1u;
+  }
+  return 0;
+}
+
+inline constexpr uint32_t MIME_HASH_SEED = findMimeHashSeed();
+static_assert(MIME_HASH_SEED != 0, "No perfect hash seed for mimeTable, increase MIME_HASH_BITS");
+
+struct MimeSlot
+{
+  const char *ext;
+  const char *mime;
+  uint8_t len;   // 0 = empty slot
+  uint8_t index; // Position in mimeTable
+};
+
+struct MimeHashTable
+{
+  MimeSlot slots[MIME_HASH_SLOTS];
+};
+
+static constexpr MimeHashTable buildMimeHashTable()
+{
+  MimeHashTable table = {};
+  for (size_t i = 0; i < MIME_TABLE_SIZE; i++)
+  {
+    const char *ext = mimeTable[i].ext;
+    size_t len = constLength(ext);
+    MimeSlot &slot = table.slots[mimeHash(ext[1], ext[len - 1], len, MIME_HASH_SEED)];
+    slot.ext = ext;
+    slot.mime = mimeTable[i].mime;
+    slot.len = (uint8_t)len;
+    slot.index = (uint8_t)i;
+  }
+  return table;
+}
+
+inline constexpr MimeHashTable mimeHashTable = buildMimeHashTable();
+
+// ========================================
+// RETURN-VALUE API
+// ========================================
+//
+// Pure functions of (path, length): no global is written, so they are
+// reentrant and can run on both cores at once. Usable in constant
+// expressions. The path does not need to be NUL terminated.
+
+#define MIME_INDEX_NONE 0xFF // mimeIndexFor() result for unknown extensions
+
+/**
+ * @brief memcmp() usable in constant expressions
+ */
+static constexpr bool extensionEquals(const char *a, const char *b, size_t len)
+{
+  for (size_t i = 0; i < len; i++)
+  {
+    if (a[i] != b[i])
+      return false;
+  }
+  return true;
+}
+
+/**
+ * @brief mimeTable index of the extension of path, MIME_INDEX_NONE when unknown
+ */
+static constexpr uint8_t mimeIndexFor(const char *path, size_t len)
+{
+  const char *dot = findExtension(path, len);
+  size_t extLen = dot ? (size_t)(path + len - dot) : 0;
+  if (extLen < 2)
+    return MIME_INDEX_NONE;
+
+  const MimeSlot &slot = mimeHashTable.slots[mimeHash(dot[1], dot[extLen - 1], extLen, MIME_HASH_SEED)];
+  return (slot.len == extLen && extensionEquals(dot, slot.ext, extLen)) ? slot.index : (uint8_t)MIME_INDEX_NONE;
+}
+
+/**
+ * @brief MIME type of an mimeTable index, application/octet-stream for MIME_INDEX_NONE
+ */
+static constexpr const char *mimeTypeOf(uint8_t index)
+{
+  return index == MIME_INDEX_NONE ? T_application_octet_stream : mimeTable[index].mime;
+}
+
+/**
+ * @brief MIME type of path
+ */
+static constexpr const char *contentTypeFor(const char *path, size_t len)
+{
+  return mimeTypeOf(mimeIndexFor(path, len));
+}
+
+static_assert(contentTypeFor("/index.html", 11) == T_text_html, "contentTypeFor: .html");
+static_assert(contentTypeFor("/fonts/roboto.woff2", 19) == T_font_woff2, "contentTypeFor: .woff2");
+static_assert(contentTypeFor("/dir.js/file", 12) == T_application_octet_stream, "contentTypeFor: dot in directory");
+static_assert(contentTypeFor("/void/extension.", 16) == T_application_octet_stream, "contentTypeFor: empty extension");
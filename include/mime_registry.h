@@ -0,0 +1,97 @@
+#pragma once
+
+#include <Arduino.h>
+#include "mime_hash.h"
+
+// ========================================
+// RUNTIME-EXTENSIBLE MIME REGISTRY
+// ========================================
+//
+// The built-in types stay in the compile-time perfect hash (mimeIndexFor()),
+// which is probed first, so a built-in lookup costs the same as before.
+// Types added at startup go to a sorted overflow array of packed extension
+// keys that is binary searched only when the built-in table misses.
+// add() and load() are meant for startup: lookups are not safe while the
+// registry is being modified. Added MIME types live in a chunked string pool
+// that never moves, so a returned type stays valid across later add() calls,
+// until clear().
+
+#define MIME_OVERFLOW_EXT_MAX 8 // Characters after the dot of an added extension
+#define MIME_POOL_CHUNK_SIZE 256 // Bytes of MIME type strings per pool chunk
+
+struct MimeOverflowEntry
+{
+  uint64_t key;     // Extension characters after the dot, packed little endian
+  const char *mime; // In the registry string pool
+};
+
+struct MimePoolChunk
+{
+  MimePoolChunk *next;
+  size_t used;
+  size_t capacity;
+  char data[]; // capacity bytes of NUL terminated MIME types
+};
+
+class MimeRegistry
+{
+public:
+  MimeRegistry() = default;
+  ~MimeRegistry() { clear(); }
+  MimeRegistry(const MimeRegistry &) = delete;
+  MimeRegistry &operator=(const MimeRegistry &) = delete;
+
+  /**
+   * @brief Map ext (with or without the leading dot) to mime
+   * @return false for a built-in or overlong extension, or when out of memory.
+   *         An extension added twice keeps the last MIME type.
+   */
+  bool add(const char *ext, const char *mime);
+
+  /**
+   * @brief Add every "ext mime/type" line of a file, '#' starts a comment
+   * @note LittleFS on the ESP32, the host file system in the native build
+   * @return Number of mappings added, -1 when the file cannot be opened
+   */
+  int load(const char *filename);
+
+  /**
+   * @brief Remove every added mapping, built-ins are not affected
+   */
+  void clear();
+
+  /**
+   * @brief MIME type of path: built-in table first, then the added mappings
+   * @note The path does not need to be NUL terminated
+   */
+  const char *lookup(const char *path, size_t len) const
+  {
+    uint8_t index = mimeIndexFor(path, len);
+    if (index != MIME_INDEX_NONE || !_count)
+      return mimeTypeOf(index);
+    return lookupOverflow(path, len);
+  }
+
+  size_t size() const { return MIME_TABLE_SIZE + _count; }
+  size_t overflowSize() const { return _count; }
+
+  /**
+   * @brief Heap bytes held by the overflow array and string pool
+   */
+  size_t footprint() const { return _capacity * sizeof(MimeOverflowEntry) + _poolBytes; }
+
+private:
+  const char *lookupOverflow(const char *path, size_t len) const;
+  const char *intern(const char *mime);
+
+  MimeOverflowEntry *_entries = nullptr; // Sorted by key
+  size_t _count = 0;
+  size_t _capacity = 0;
+  MimePoolChunk *_pool = nullptr;        // Newest chunk first, chunks are never reallocated
+  size_t _poolBytes = 0;
+};
+
+/**
+ * @brief Registry used by the benchmark, filled from MIME_TYPES_FILE at startup
+ */
+MimeRegistry &mimeRegistry();
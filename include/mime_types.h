@@ -0,0 +1,154 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// ========================================
+// MOCK DEFINITIONS
+// ========================================
+
+// extensions & MIME-Types
+inline constexpr const char *T__avif = ".avif";                                   // AVIF: Highly compressed images. Compatible with all modern browsers.
+inline constexpr const char *T__csv = ".csv";                                     // CSV: Data logging and configuration
+inline constexpr const char *T__css = ".css";                                     // CSS: Styling for web interfaces
+inline constexpr const char *T__gif = ".gif";                                     // GIF: Simple animations. Legacy support
+inline constexpr const char *T__gz = ".gz";                                       // GZ: compressed files
+inline constexpr const char *T__htm = ".htm";                                     // HTM: Web interface files
+inline constexpr const char *T__html = ".html";                                   // HTML: Web interface files
+inline constexpr const char *T__ico = ".ico";                                     // ICO: Favicons, system icons. Legacy support
+inline constexpr const char *T__jpg = ".jpg";                                     // JPEG/JPG: Photos. Legacy support
+inline constexpr const char *T__js = ".js";                                       // JavaScript: Interactive functionality
+inline constexpr const char *T__json = ".json";                                   // JSON: Data exchange format
+inline constexpr const char *T__mp4 = ".mp4";                                     // MP4: Proprietary format. Worse compression than WEBM.
+inline constexpr const char *T__opus = ".opus";                                   // OPUS: High compression audio format
+inline constexpr const char *T__pdf = ".pdf";                                     // PDF: Universal document format
+inline constexpr const char *T__png = ".png";                                     // PNG: Icons, logos, transparency. Legacy support
+inline constexpr const char *T__svg = ".svg";                                     // SVG: Vector graphics, icons (scalable, tiny file sizes)
+inline constexpr const char *T__ttf = ".ttf";                                     // TTF: Font file. Legacy support
+inline constexpr const char *T__txt = ".txt";                                     // TXT: Plain text files
+inline constexpr const char *T__webm = ".webm";                                   // WebM: Video. Open source, optimized for web. Compatible with all modern browsers.
+inline constexpr const char *T__webp = ".webp";                                   // WebP: Highly compressed images. Compatible with all modern browsers.
+inline constexpr const char *T__woff = ".woff";                                   // WOFF: Font file. Legacy support
+inline constexpr const char *T__woff2 = ".woff2";                                 // WOFF2: Better compression. Compatible with all modern browsers.
+inline constexpr const char *T__xml = ".xml";                                     // XML: Configuration and data files
+inline constexpr const char *T_application_javascript = "application/javascript"; // Obsolete type for JavaScript
+inline constexpr const char *T_application_json = "application/json";
+inline constexpr const char *T_application_msgpack = "application/msgpack";
+inline constexpr const char *T_application_octet_stream = "application/octet-stream";
+inline constexpr const char *T_application_pdf = "application/pdf";
+inline constexpr const char *T_app_xform_urlencoded = "application/x-www-form-urlencoded";
+inline constexpr const char *T_audio_opus = "audio/opus";
+inline constexpr const char *T_font_ttf = "font/ttf";
+inline constexpr const char *T_font_woff = "font/woff";
+inline constexpr const char *T_font_woff2 = "font/woff2";
+inline constexpr const char *T_image_avif = "image/avif";
+inline constexpr const char *T_image_gif = "image/gif";
+inline constexpr const char *T_image_jpeg = "image/jpeg";
+inline constexpr const char *T_image_png = "image/png";
+inline constexpr const char *T_image_svg_xml = "image/svg+xml";
+inline constexpr const char *T_image_webp = "image/webp";
+inline constexpr const char *T_image_x_icon = "image/x-icon";
+inline constexpr const char *T_text_css = "text/css";
+inline constexpr const char *T_text_csv = "text/csv";
+inline constexpr const char *T_text_event_stream = "text/event-stream";
+inline constexpr const char *T_text_html = "text/html";
+inline constexpr const char *T_text_javascript = "text/javascript";
+inline constexpr const char *T_text_plain = "text/plain";
+inline constexpr const char *T_text_xml = "text/xml";
+inline constexpr const char *T_video_mp4 = "video/mp4";
+inline constexpr const char *T_video_webm = "video/webm";
+
+// Global variable to simulate contentType pointer, defined in main.cpp
+extern const char *_contentType;
+
+// Content-Encoding of a pre-compressed file (.gz / .br suffix), set by the versions that support it
+enum ContentEncoding : uint8_t
+{
+  ENCODING_IDENTITY,
+  ENCODING_GZIP,
+  ENCODING_BROTLI
+};
+
+// Global variable to simulate contentEncoding, defined in main.cpp
+extern ContentEncoding _contentEncoding;
+
+// ========================================
+// MIME TABLE
+// ========================================
+
+struct MimeEntry
+{
+  const char *ext;
+  const char *mime;
+};
+
+// Extension -> MIME mapping served by every version (same set as v1)
+inline constexpr MimeEntry mimeTable[] = {
+    {T__html, T_text_html},
+    {T__htm, T_text_html},
+    {T__css, T_text_css},
+    {T__js, T_application_javascript},
+    {T__json, T_application_json},
+    {T__png, T_image_png},
+    {T__ico, T_image_x_icon},
+    {T__svg, T_image_svg_xml},
+    {T__jpg, T_image_jpeg},
+    {T__webp, T_image_webp},
+    {T__avif, T_image_avif},
+    {T__gif, T_image_gif},
+    {T__woff2, T_font_woff2},
+    {T__woff, T_font_woff},
+    {T__ttf, T_font_ttf},
+    {T__xml, T_text_xml},
+    {T__pdf, T_application_pdf},
+    {T__mp4, T_video_mp4},
+    {T__opus, T_audio_opus},
+    {T__webm, T_video_webm},
+    {T__txt, T_text_plain},
+};
+inline constexpr size_t MIME_TABLE_SIZE = sizeof(mimeTable) / sizeof(mimeTable[0]);
+
+/**
+ * @brief strlen() usable in constant expressions
+ */
+static constexpr size_t constLength(const char *s)
+{
+  size_t n = 0;
+  while (s[n])
+    n++;
+  return n;
+}
+
+/**
+ * @brief Longest extension in mimeTable, dot included
+ */
+static constexpr size_t mimeMaxExtLength()
+{
+  size_t longest = 0;
+  for (size_t i = 0; i < MIME_TABLE_SIZE; i++)
+    longest = constLength(mimeTable[i].ext) > longest ? constLength(mimeTable[i].ext) : longest;
+  return longest;
+}
+inline constexpr size_t MIME_EXT_MAX_LEN = mimeMaxExtLength();
+
+/**
+ * @brief Find the extension of a path by scanning back from its end
+ * @return Pointer to the dot, or nullptr when a '/' or more than MIME_EXT_MAX_LEN
+ *         bytes come before the last dot (no known extension can match then)
+ * @note At most MIME_EXT_MAX_LEN bytes are read, whatever the path depth.
+ *       Returns the same match/no-match outcome as strrchr(path, '.').
+ */
+static constexpr const char *findExtension(const char *path, size_t len)
+{
+  const char *p = path + len;
+  const char *stop = len > MIME_EXT_MAX_LEN ? p - MIME_EXT_MAX_LEN : path;
+  while (p > stop)
+  {
+    char c = *--p;
+    if (c == '.')
+      return p;
+    if (c == '/')
+      return nullptr;
+  }
+  return nullptr;
+}
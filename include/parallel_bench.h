@@ -0,0 +1,43 @@
+#pragma once
+
+#include <Arduino.h>
+
+// ========================================
+// PARALLEL THROUGHPUT BENCHMARK
+// ========================================
+//
+// Runs one resolver on several workers at once, released together by a
+// start barrier. ESP32: FreeRTOS tasks pinned to each core. Host: one
+// std::thread per hardware thread.
+// Workers call return-value resolvers and store each result into a sink:
+// their own cache line, or one sink shared by all workers to measure the
+// cost of a contended global such as _contentType. Sinks are relaxed
+// atomics, so concurrent stores are defined behavior.
+
+#define PARALLEL_MAX_WORKERS 16
+
+/**
+ * @brief Return-value resolver run by the workers, must be reentrant
+ */
+typedef const char *(*ParallelResolverFn)(const char *path, size_t len);
+
+struct ParallelResult
+{
+  int workers;
+  double callsPerSecond;                             // All workers together
+  double workerCallsPerSecond[PARALLEL_MAX_WORKERS]; // Each worker on its own
+};
+
+/**
+ * @brief Number of cores (ESP32) or hardware threads (host) available
+ */
+int parallelMaxWorkers();
+
+/**
+ * @brief Run func iterations times on each of workers workers, cycling through paths
+ * @param sharedSink Every worker stores into the same sink instead of its own
+ * @return false when a worker could not be started (result not set); the
+ *         workers already started are released and have ended
+ */
+bool benchmarkParallel(ParallelResolverFn func, const String paths[], int pathCount, int iterations, int workers,
+                       bool sharedSink, ParallelResult &result);
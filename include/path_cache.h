@@ -0,0 +1,58 @@
+#pragma once
+
+#include <Arduino.h>
+#include "resolver_registry.h"
+
+// ========================================
+// PATH -> MIME MEMOIZATION CACHE
+// ========================================
+//
+// Direct-mapped, allocation-free cache in front of a resolver. The key is
+// the last 8 bytes of the path (zero padded when shorter): every resolver
+// only looks at what follows the last dot, and an extension that does not
+// fit in those 8 bytes is longer than any known one, so the key decides the
+// MIME type exactly. Hashing it costs one length read and one 8-byte load,
+// whatever the path depth.
+
+#define PATH_CACHE_SLOTS 16 // Power of two
+
+struct PathCacheStats
+{
+  uint32_t hits;
+  uint32_t misses;
+};
+
+class PathCache
+{
+public:
+  explicit PathCache(ResolverFn backend) : _backend(backend) { clear(); }
+
+  /**
+   * @brief Set _contentType for path, from the cache or through the backend resolver
+   */
+  void resolve(const String &path);
+
+  void clear();
+  const PathCacheStats &stats() const { return _stats; }
+  void resetStats() { _stats = {0, 0}; }
+
+  static constexpr size_t footprint() { return sizeof(PathCache); }
+
+private:
+  struct Slot
+  {
+    uint64_t key;
+    const char *mime; // nullptr = empty
+  };
+
+  ResolverFn _backend;
+  Slot _slots[PATH_CACHE_SLOTS];
+  PathCacheStats _stats;
+};
+
+/**
+ * @brief Version 7: PathCache in front of Version 4
+ */
+void _setContentTypeFromPath_v7(const String &path);
+
+PathCache &version7Cache();
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <Arduino.h>
+
+// ========================================
+// IRAM / DRAM vs FLASH PLACEMENT STUDY
+// ========================================
+//
+// The same two lookup strategies built twice: code and tables in flash
+// (reached through the instruction/data cache), and code in IRAM with the
+// table in DRAM. Each is timed with warm caches and with the flash cache
+// evicted before every call. On the host the attributes are no-ops and
+// eviction only flushes the CPU caches.
+// On the ESP32, eviction maps the app partition and invalidates the
+// instruction cache through a ROM call. That code has not been built for
+// the target yet, so it is opt-in: build with -DPLACEMENT_DEVICE_EVICTION=1.
+// Without it the device runs the hot measurements only.
+
+#ifndef PLACEMENT_DEVICE_EVICTION
+#define PLACEMENT_DEVICE_EVICTION 0
+#endif
+
+/**
+ * @brief Verify the placement variants and print hot (and, where eviction is built, cold) latency for each
+ * @param paths Test paths, already built as String
+ * @param pathCount Number of paths
+ * @return false when a variant disagrees with contentTypeFor()
+ */
+bool runPlacementStudy(const String paths[], int pathCount);
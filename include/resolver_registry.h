@@ -0,0 +1,58 @@
+#pragma once
+
+#include <Arduino.h>
+
+// ========================================
+// RESOLVER REGISTRY
+// ========================================
+//
+// Every _setContentTypeFromPath_vN registers itself with REGISTER_RESOLVER.
+// Verification, memory test, benchmarks and comparisons iterate over the
+// registry, so a new variant needs no harness changes.
+
+#define RESOLVER_REGISTRY_MAX 32 // Maximum number of registered resolvers
+
+typedef void (*ResolverFn)(const String &path);
+
+// ResolverCandidate::flags
+#define RESOLVER_EXTENDED_SEMANTICS 0x02 // Case-insensitive with .gz/.br suffixes, checked against its own reference
+
+struct ResolverCandidate
+{
+  const char *name;
+  ResolverFn func;
+  int order; // Sort key, the lowest one is the baseline of every comparison
+  uint8_t flags;
+};
+
+/**
+ * @brief Add a resolver, kept sorted by order
+ * @return false when the registry is full
+ */
+bool registerResolver(const char *name, ResolverFn func, int order, uint8_t flags = 0);
+
+int resolverCount();
+const ResolverCandidate &resolverAt(int index);
+
+struct ResolverRegistrar
+{
+  ResolverRegistrar(const char *name, ResolverFn func, int order, uint8_t flags = 0)
+  {
+    registerResolver(name, func, order, flags);
+  }
+};
+
+#define REGISTER_RESOLVER_CONCAT2(a, b) a##b
+#define REGISTER_RESOLVER_CONCAT(a, b) REGISTER_RESOLVER_CONCAT2(a, b)
+
+/**
+ * @brief Register func under name at static initialization time
+ */
+#define REGISTER_RESOLVER(func, name, order) \
+  static ResolverRegistrar REGISTER_RESOLVER_CONCAT(resolverRegistrar_, __LINE__)(name, func, order)
+
+/**
+ * @brief Register func with RESOLVER_* flags
+ */
+#define REGISTER_RESOLVER_FLAGS(func, name, order, flags) \
+  static ResolverRegistrar REGISTER_RESOLVER_CONCAT(resolverRegistrar_, __LINE__)(name, func, order, flags)
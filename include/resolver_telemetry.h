@@ -0,0 +1,163 @@
+#pragma once
+
+#include <Arduino.h>
+#include <atomic>
+#include "cycle_timer.h"
+#include "mime_hash.h"
+
+#if !defined(BENCH_NATIVE)
+#include <freertos/FreeRTOS.h>
+#endif
+
+// ========================================
+// RESOLVER TELEMETRY
+// ========================================
+//
+// Always-on counters for the production lookup path. Each core (host:
+// each of up to TELEMETRY_MAX_CORES threads) owns a cache line aligned
+// slot that only it writes. A call costs one counter update: the count of
+// its mimeTable index (or of the misses), a relaxed load and store, never a
+// read-modify-write, while telemetryCollect() may read it from any core.
+// Calls are the sum of the counts. Two tasks on the same core can lose an
+// increment when one preempts the other mid-update; that is accepted for
+// statistics.
+// When a count reaches a multiple of TELEMETRY_SAMPLE_INTERVAL, the lookup
+// is repeated once under the cycle counter, out of line.
+// Build with -DRESOLVER_TELEMETRY=0 to compile the counting out.
+
+#ifndef RESOLVER_TELEMETRY
+#define RESOLVER_TELEMETRY 1
+#endif
+
+#define TELEMETRY_MAX_CORES 4
+#define TELEMETRY_SAMPLE_INTERVAL 1024 // Calls of one MIME type between two timed lookups, per core (power of two)
+
+static_assert((TELEMETRY_SAMPLE_INTERVAL & (TELEMETRY_SAMPLE_INTERVAL - 1)) == 0,
+              "TELEMETRY_SAMPLE_INTERVAL must be a power of two");
+
+typedef std::atomic<uint32_t> TelemetryCounter;
+
+struct alignas(64) TelemetryCounters
+{
+  TelemetryCounter counts[MIME_TABLE_SIZE + 1]; // Calls per mimeTable entry, the last one counts misses
+  TelemetryCounter samples;                      // Timed calls
+  TelemetryCounter sampledCycles;                // Sum over the timed calls
+  TelemetryCounter maxCycles;                    // Slowest timed call of report maxEpoch
+  TelemetryCounter maxEpoch;                     // telemetryEpoch when maxCycles was written
+};
+
+struct TelemetryReport
+{
+  uint32_t intervalMs; // Covered by this report
+  uint32_t calls;
+  uint32_t misses;
+  uint32_t hits[MIME_TABLE_SIZE];
+  uint32_t samples;
+  uint32_t maxCycles; // Timer overhead removed
+  double meanCycles;  // Timer overhead removed
+  uint32_t callsPerCore[TELEMETRY_MAX_CORES];
+};
+
+typedef void (*TelemetryCallback)(const TelemetryReport &report);
+
+extern TelemetryCounters telemetryCounters[TELEMETRY_MAX_CORES];
+
+// Report being accumulated, advanced by telemetryCollect(). A core resets
+// its own maxCycles when it sees a new epoch, so the collector never
+// writes a slot it does not own.
+extern TelemetryCounter telemetryEpoch;
+
+/**
+ * @brief Add to a counter owned by the calling core: relaxed load and store, no atomic read-modify-write
+ */
+static inline void telemetryAdd(TelemetryCounter &counter, uint32_t value)
+{
+  counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Host: next free slot for a new thread, threads past TELEMETRY_MAX_CORES share slots
+ */
+int telemetryAssignSlot();
+
+/**
+ * @brief Slot of the calling core (ESP32) or thread (host)
+ */
+static inline int telemetrySlot()
+{
+#if defined(BENCH_NATIVE)
+  static thread_local int slot = -1; // Constant initialized: no TLS guard
+  if (__builtin_expect(slot < 0, 0))
+    slot = telemetryAssignSlot();
+  return slot;
+#else
+  return xPortGetCoreID();
+#endif
+}
+
+/**
+ * @brief Counters of the calling core, to fetch once and pass to resolveContentType()
+ * @note Valid as long as the caller stays on this core: a task pinned to a core
+ *       (the AsyncTCP task is), or a host thread.
+ */
+static inline TelemetryCounters &telemetryLocalCounters()
+{
+  return telemetryCounters[telemetrySlot()];
+}
+
+/**
+ * @brief Time a repeat of the lookup of path and record it in the current report
+ * @note Out of line and cold: only the sampled calls pay for it
+ */
+void telemetrySampleLookup(TelemetryCounters &counters, const char *path, size_t len);
+
+/**
+ * @brief MIME type of path, counted in counters
+ * @param counters telemetryLocalCounters() of the calling core
+ * @note Same result as contentTypeFor()
+ */
+static inline const char *resolveContentType(TelemetryCounters &counters, const char *path, size_t len)
+{
+#if RESOLVER_TELEMETRY
+  uint8_t index = mimeIndexFor(path, len);
+  TelemetryCounter &count = counters.counts[index < MIME_TABLE_SIZE ? index : MIME_TABLE_SIZE];
+  uint32_t seen = count.load(std::memory_order_relaxed);
+  count.store(seen + 1, std::memory_order_relaxed);
+  if (__builtin_expect((seen & (TELEMETRY_SAMPLE_INTERVAL - 1)) == 0, 0))
+    telemetrySampleLookup(counters, path, len);
+  return mimeTypeOf(index);
+#else
+  (void)counters;
+  return contentTypeFor(path, len);
+#endif
+}
+
+/**
+ * @brief resolveContentType() for callers that do not keep their counters
+ * @note Pays the core (host: thread) lookup on every call
+ */
+static inline const char *resolveContentType(const char *path, size_t len)
+{
+  return resolveContentType(telemetryLocalCounters(), path, len);
+}
+
+/**
+ * @brief Sum of all cores since the previous report, which becomes the new starting point
+ * @note Single collector: call from one task only (loop() through telemetryPoll())
+ */
+void telemetryCollect(TelemetryReport &report);
+
+/**
+ * @brief Where periodic reports go, nullptr = printTelemetryReport()
+ */
+void setTelemetryCallback(TelemetryCallback callback);
+
+/**
+ * @brief Emit a report when intervalMs elapsed since the previous one; call from loop()
+ */
+void telemetryPoll(uint32_t intervalMs);
+
+/**
+ * @brief One compact line: call rate, miss rate, sampled cycles, top MIME types
+ */
+void printTelemetryReport(const TelemetryReport &report);
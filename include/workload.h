@@ -0,0 +1,57 @@
+#pragma once
+
+#include <Arduino.h>
+
+// ========================================
+// WORKLOADS
+// ========================================
+//
+// A workload is a pool of distinct paths, pre-built as String, plus the
+// order in which they are requested. Replaying it through a resolver
+// costs one table read per call and no allocation.
+
+#define WORKLOAD_MAX_PATHS 64     // Distinct paths per workload
+#define WORKLOAD_MAX_LENGTH 4096  // Requests per workload
+
+struct Workload
+{
+  const char *name;
+  int pathCount;
+  String paths[WORKLOAD_MAX_PATHS];
+  int length;
+  uint8_t sequence[WORKLOAD_MAX_LENGTH];
+};
+
+/**
+ * @brief paths[0..count) in order, repeated: the classic iter % count pattern
+ */
+void buildSequentialWorkload(Workload &workload, const char *const paths[], int count);
+
+/**
+ * @brief Every path equally often, in a shuffled order
+ */
+void buildUniformWorkload(Workload &workload, const char *const paths[], int count, uint32_t seed);
+
+/**
+ * @brief Zipf distributed requests: paths[k] is requested with weight 1 / (k + 1)^exponent
+ */
+void buildZipfWorkload(Workload &workload, const char *const paths[], int count, double exponent, uint32_t seed);
+
+/**
+ * @brief Zipf workload whose popularity ranking rotates every WORKLOAD_MAX_LENGTH / phases requests
+ */
+void buildShiftingWorkload(Workload &workload, const char *const paths[], int count, double exponent, int phases,
+                           uint32_t seed);
+
+/**
+ * @brief Trace embedded at build time from data/access_sample.log (tools/gen_access_trace.py)
+ */
+void buildEmbeddedTraceWorkload(Workload &workload);
+
+/**
+ * @brief Load a trace file: access log lines ("GET /path HTTP/1.1") or one path per line
+ * @note LittleFS on the ESP32, the host file system in the native build.
+ *       Query strings are dropped. Paths beyond WORKLOAD_MAX_PATHS distinct ones are skipped.
+ * @return false when the file cannot be opened or holds no request
+ */
+bool loadTraceWorkload(Workload &workload, const char *filename);
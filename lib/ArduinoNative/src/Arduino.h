@@ -0,0 +1,179 @@
+#pragma once
+
+// ========================================
+// ARDUINO COMPATIBILITY LAYER FOR LINUX HOST
+// ========================================
+//
+// Only the subset of the Arduino-ESP32 core used by the benchmark is
+// provided. Selected through [env:native] in platformio.ini.
+
+#include <algorithm>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <math.h>
+
+#include "esp_attr.h"
+
+using std::max;
+using std::min;
+
+// ========================================
+// STRING
+// ========================================
+
+/**
+ * @brief Heap backed string with the Arduino String interface
+ * @note The buffer is always allocated on the heap (no small string
+ *       optimization), so String construction cost is an upper bound
+ *       of the one paid on the ESP32.
+ */
+class String
+{
+public:
+  String(const char *cstr = "") { copy(cstr, cstr ? strlen(cstr) : 0); }
+  String(const char *cstr, size_t length) { copy(cstr, length); }
+  String(const String &other) { copy(other._buffer, other._len); }
+  String(String &&other) noexcept : _buffer(other._buffer), _len(other._len)
+  {
+    other._buffer = nullptr;
+    other._len = 0;
+  }
+  ~String() { free(_buffer); }
+
+  String &operator=(const String &other)
+  {
+    if (this != &other)
+    {
+      free(_buffer);
+      copy(other._buffer, other._len);
+    }
+    return *this;
+  }
+  String &operator=(String &&other) noexcept
+  {
+    if (this != &other)
+    {
+      free(_buffer);
+      _buffer = other._buffer;
+      _len = other._len;
+      other._buffer = nullptr;
+      other._len = 0;
+    }
+    return *this;
+  }
+  String &operator=(const char *cstr)
+  {
+    // cstr may point into _buffer (s = s.c_str()): copy before freeing
+    char *old = _buffer;
+    copy(cstr, cstr ? strlen(cstr) : 0);
+    free(old);
+    return *this;
+  }
+
+  const char *c_str() const { return _buffer ? _buffer : ""; }
+  unsigned int length() const { return (unsigned int)_len; }
+  char operator[](unsigned int index) const { return index < _len ? _buffer[index] : 0; }
+  bool operator==(const String &rhs) const { return _len == rhs._len && memcmp(c_str(), rhs.c_str(), _len) == 0; }
+  bool operator==(const char *rhs) const { return strcmp(c_str(), rhs ? rhs : "") == 0; }
+
+private:
+  void copy(const char *cstr, size_t length)
+  {
+    _len = length;
+    _buffer = (char *)malloc(length + 1);
+    if (length)
+      memcpy(_buffer, cstr, length);
+    _buffer[length] = '\0';
+  }
+
+  char *_buffer = nullptr;
+  size_t _len = 0;
+};
+
+// ========================================
+// SERIAL
+// ========================================
+
+class HardwareSerial
+{
+public:
+  void begin(unsigned long) {}
+  operator bool() const { return true; }
+
+  size_t print(const char *str) { return fputs(str, stdout) >= 0 ? strlen(str) : 0; }
+  size_t print(const String &str) { return print(str.c_str()); }
+  size_t println() { return print("\n"); }
+  size_t println(const char *str) { return print(str) + println(); }
+  size_t println(const String &str) { return println(str.c_str()); }
+  size_t printf(const char *format, ...)
+  {
+    va_list args;
+    va_start(args, format);
+    int written = vprintf(format, args);
+    va_end(args);
+    return written > 0 ? (size_t)written : 0;
+  }
+  void flush() { fflush(stdout); }
+};
+
+extern HardwareSerial Serial;
+
+// ========================================
+// TIMING
+// ========================================
+
+unsigned long millis();
+unsigned long micros();
+void delay(uint32_t ms);
+
+// ========================================
+// SYSTEM / FREERTOS STAND-INS
+// ========================================
+
+typedef unsigned int UBaseType_t;
+typedef void *TaskHandle_t;
+
+/**
+ * @brief No stack watermark on the host: always reports an untouched stack
+ */
+inline UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t) { return 0; }
+
+uint32_t getCpuFrequencyMhz();
+
+/**
+ * @brief Ticks per microsecond of the readCycles() counter: the TSC calibrated once
+ *        against CLOCK_MONOTONIC, 1000 (nanoseconds) on hosts without one
+ */
+uint32_t hostCounterTicksPerMicro();
+
+/**
+ * @brief Exit status of the host program once setup() and the loop() passes are done, 0 by default
+ */
+void hostSetExitStatus(int status);
+
+/**
+ * @brief The host clock cannot be changed: only succeeds for the current frequency
+ */
+inline bool setCpuFrequencyMhz(uint32_t mhz) { return mhz == getCpuFrequencyMhz(); }
+
+class EspClass
+{
+public:
+  uint32_t getFreeHeap();
+  uint32_t getFreePsram() { return 0; }
+  uint32_t getPsramSize() { return 0; }
+  uint32_t getFlashChipSpeed() { return 0; }
+  uint32_t getFlashChipSize() { return 0; }
+  const char *getChipModel() { return "Linux host"; }
+  uint8_t getChipRevision() { return 0; }
+};
+
+extern EspClass ESP;
+
+// Sketch entry points, called from the host main()
+void setup();
+void loop();
@@ -0,0 +1,144 @@
+#include "Arduino.h"
+#include "esp_timer.h"
+
+#include <malloc.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// Clock reported when the host gives none: one tick per ns, the rate of the
+// CLOCK_MONOTONIC fallback of readCycles() on non-x86 hosts
+#define HOST_DEFAULT_CPU_MHZ 1000
+
+HardwareSerial Serial;
+EspClass ESP;
+
+// ========================================
+// TIMING
+// ========================================
+
+static int64_t monotonicMicros()
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static const int64_t bootMicros = monotonicMicros();
+
+int64_t esp_timer_get_time()
+{
+  return monotonicMicros() - bootMicros;
+}
+
+unsigned long micros()
+{
+  return (unsigned long)esp_timer_get_time();
+}
+
+unsigned long millis()
+{
+  return (unsigned long)(esp_timer_get_time() / 1000);
+}
+
+void delay(uint32_t ms)
+{
+  struct timespec ts = {(time_t)(ms / 1000), (long)(ms % 1000) * 1000000L};
+  while (nanosleep(&ts, &ts) != 0)
+  {
+  }
+}
+
+// ========================================
+// SYSTEM
+// ========================================
+
+/**
+ * @brief Base (nominal) clock of the first core from cpufreq, 0 when the driver does not expose it
+ * @note Unlike "cpu MHz" in /proc/cpuinfo this does not follow frequency scaling
+ */
+static uint32_t cpufreqBaseMhz()
+{
+  FILE *f = fopen("/sys/devices/system/cpu/cpu0/cpufreq/base_frequency", "r");
+  if (!f)
+    return 0;
+  unsigned long khz = 0;
+  if (fscanf(f, "%lu", &khz) != 1)
+    khz = 0;
+  fclose(f);
+  return (uint32_t)((khz + 500) / 1000);
+}
+
+uint32_t hostCounterTicksPerMicro()
+{
+  static uint32_t ticksPerMicro = 0;
+  if (ticksPerMicro)
+    return ticksPerMicro;
+#if defined(__x86_64__) || defined(__i386__)
+  int64_t start = monotonicMicros();
+  uint64_t startTicks = __rdtsc();
+  int64_t elapsed;
+  while ((elapsed = monotonicMicros() - start) < 20000)
+  {
+  }
+  ticksPerMicro = (uint32_t)((__rdtsc() - startTicks + elapsed / 2) / (uint64_t)elapsed);
+#endif
+  if (!ticksPerMicro)
+    ticksPerMicro = HOST_DEFAULT_CPU_MHZ;
+  return ticksPerMicro;
+}
+
+/**
+ * @brief Nominal clock of the first host core, never 0
+ * @note cpufreq base_frequency, else the invariant TSC rate (which runs at the
+ *       nominal clock), else HOST_DEFAULT_CPU_MHZ
+ */
+uint32_t getCpuFrequencyMhz()
+{
+  static uint32_t mhz = 0;
+  if (!mhz)
+    mhz = cpufreqBaseMhz();
+  if (!mhz)
+    mhz = hostCounterTicksPerMicro();
+  return mhz;
+}
+
+uint32_t EspClass::getFreeHeap()
+{
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+  return (uint32_t)mallinfo2().fordblks;
+#else
+  return 0;
+#endif
+}
+
+// ========================================
+// HOST ENTRY POINT
+// ========================================
+
+static int exitStatus = 0;
+
+void hostSetExitStatus(int status)
+{
+  exitStatus = status;
+}
+
+#if !defined(BENCH_FUZZ) // The fuzzer brings its own main()
+/**
+ * @brief Run setup() once, then loop() as many times as given in argv[1]
+ */
+int main(int argc, char **argv)
+{
+  long loops = argc > 1 ? strtol(argv[1], nullptr, 10) : 0;
+
+  setup();
+  for (long i = 0; i < loops; i++)
+  {
+    loop();
+  }
+  Serial.flush();
+  return exitStatus;
+}
+#endif
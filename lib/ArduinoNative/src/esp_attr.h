@@ -0,0 +1,5 @@
+#pragma once
+
+// Memory placement attributes have no meaning on the host
+#define IRAM_ATTR
+#define DRAM_ATTR
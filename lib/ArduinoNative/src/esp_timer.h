@@ -0,0 +1,8 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief Microseconds since start-up, from CLOCK_MONOTONIC
+ */
+int64_t esp_timer_get_time();
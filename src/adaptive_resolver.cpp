@@ -0,0 +1,114 @@
+#include "adaptive_resolver.h"
+#include "resolver_registry.h"
+
+struct AdaptiveProbe
+{
+  uint8_t len;   // Extension length, dot included
+  char first;    // Character after the dot
+};
+
+static constexpr AdaptiveProbe makeProbe(const char *ext)
+{
+  return {(uint8_t)constLength(ext), ext[1]};
+}
+
+struct AdaptiveProbeTable
+{
+  AdaptiveProbe probes[MIME_TABLE_SIZE];
+};
+
+static constexpr AdaptiveProbeTable buildProbeTable()
+{
+  AdaptiveProbeTable table = {};
+  for (size_t i = 0; i < MIME_TABLE_SIZE; i++)
+    table.probes[i] = makeProbe(mimeTable[i].ext);
+  return table;
+}
+
+static constexpr AdaptiveProbeTable probeTable = buildProbeTable();
+
+static AdaptiveResolverStats stats;
+static uint32_t callsUntilReorder = ADAPTIVE_REORDER_INTERVAL;
+
+void resetAdaptiveResolver()
+{
+  memset(&stats, 0, sizeof(stats));
+  for (size_t i = 0; i < MIME_TABLE_SIZE; i++)
+    stats.order[i] = (uint8_t)i;
+  callsUntilReorder = ADAPTIVE_REORDER_INTERVAL;
+}
+
+// Initial probe order, set before setup() runs
+static const bool statsInitialized = (resetAdaptiveResolver(), true);
+
+/**
+ * @brief Stable sort of the probe order by hit count, then halve the counters
+ */
+static void reorderProbes()
+{
+  for (size_t i = 1; i < MIME_TABLE_SIZE; i++)
+  {
+    uint8_t entry = stats.order[i];
+    size_t j = i;
+    for (; j > 0 && stats.hits[stats.order[j - 1]] < stats.hits[entry]; j--)
+      stats.order[j] = stats.order[j - 1];
+    stats.order[j] = entry;
+  }
+  for (size_t i = 0; i < MIME_TABLE_SIZE; i++)
+    stats.hits[i] >>= 1;
+  stats.reorders++;
+}
+
+/**
+ * @brief Adaptive version: probe order learned from the observed traffic
+ */
+void _setContentTypeFromPath_v6(const String &path)
+{
+  stats.calls++;
+  if (--callsUntilReorder == 0)
+  {
+    callsUntilReorder = ADAPTIVE_REORDER_INTERVAL;
+    reorderProbes();
+  }
+
+  const char *dot = strrchr(path.c_str(), '.');
+  size_t len = dot ? strlen(dot) : 0;
+  if (len >= 2 && len <= MIME_EXT_MAX_LEN)
+  {
+    for (size_t k = 0; k < MIME_TABLE_SIZE; k++)
+    {
+      uint8_t index = stats.order[k];
+      const AdaptiveProbe &probe = probeTable.probes[index];
+      if (probe.len == len && probe.first == dot[1] && memcmp(dot, mimeTable[index].ext, len) == 0)
+      {
+        stats.probes += k + 1;
+        stats.hits[index]++;
+        _contentType = mimeTable[index].mime;
+        return;
+      }
+    }
+    stats.probes += MIME_TABLE_SIZE;
+  }
+  stats.misses++;
+  _contentType = T_application_octet_stream;
+}
+REGISTER_RESOLVER(_setContentTypeFromPath_v6, "Version 6", 6);
+
+const AdaptiveResolverStats &adaptiveResolverStats()
+{
+  return stats;
+}
+
+void printAdaptiveResolverStats()
+{
+  Serial.println("=== ADAPTIVE RESOLVER (Version 6) ===");
+  Serial.printf("Calls: %u, misses: %u, reorders: %u, average probes per call: %0.2f\n", stats.calls, stats.misses,
+                stats.reorders, stats.calls ? (double)stats.probes / stats.calls : 0.0);
+  Serial.print("Probe order (decayed hits):");
+  for (size_t k = 0; k < MIME_TABLE_SIZE; k++)
+  {
+    uint8_t index = stats.order[k];
+    Serial.printf(" %s(%u)", mimeTable[index].ext, stats.hits[index]);
+  }
+  Serial.println("\n");
+}
@@ -0,0 +1,193 @@
+#include "bench_engine.h"
+
+#include <algorithm>
+#include <math.h>
+
+// Scale factor turning the MAD into a consistent estimator of the standard deviation
+#define MAD_TO_SIGMA 1.4826
+
+// Bootstrap statistics, static to keep them off the loopTask stack
+static float bootstrapBuffer[BENCH_MAX_BOOTSTRAP];
+
+/**
+ * @brief Deterministic xorshift32 so runs are reproducible
+ */
+static uint32_t nextRandom(uint32_t &state)
+{
+  state ^= state << 13;
+  state ^= state >> 17;
+  state ^= state << 5;
+  return state;
+}
+
+/**
+ * @brief Median of values, which are reordered as a side effect
+ * @note nth_element: O(n) on average, only the middle order statistics are placed
+ */
+static double selectMedian(double *values, int count)
+{
+  if (count == 0)
+    return 0;
+  double *middle = values + count / 2;
+  std::nth_element(values, middle, values + count);
+  if (count & 1)
+    return *middle;
+  // The lower middle is the largest value left of it
+  return (*std::max_element(values, middle) + *middle) / 2.0;
+}
+
+/**
+ * @brief Median of a bootstrap resample of values
+ */
+static double resampledMedian(const double *values, int count, uint32_t &state)
+{
+  double resample[BENCH_MAX_ROUNDS];
+  for (int i = 0; i < count; i++)
+    resample[i] = values[nextRandom(state) % count];
+  return selectMedian(resample, count);
+}
+
+/**
+ * @brief Percentile interval of the first count entries of bootstrapBuffer
+ */
+static void bootstrapInterval(int count, double confidence, double &low, double &high)
+{
+  int lowIndex = (int)((1.0 - confidence) / 2.0 * (count - 1) + 0.5);
+  int highIndex = (count - 1) - lowIndex;
+  std::nth_element(bootstrapBuffer, bootstrapBuffer + lowIndex, bootstrapBuffer + count);
+  low = bootstrapBuffer[lowIndex];
+  std::nth_element(bootstrapBuffer + lowIndex, bootstrapBuffer + highIndex, bootstrapBuffer + count);
+  high = bootstrapBuffer[highIndex];
+}
+
+void benchSummarize(const char *name, const double *samples, int count, const BenchConfig &config,
+                    BenchResult &result)
+{
+  double sorted[BENCH_MAX_ROUNDS];
+  double deviations[BENCH_MAX_ROUNDS];
+
+  count = count > BENCH_MAX_ROUNDS ? BENCH_MAX_ROUNDS : count;
+  memcpy(sorted, samples, count * sizeof(double));
+  double median = selectMedian(sorted, count);
+  for (int i = 0; i < count; i++)
+    deviations[i] = fabs(samples[i] - median);
+  double mad = selectMedian(deviations, count);
+
+  // Reject rounds hit by interrupts, cache refills, etc.
+  double limit = config.outlierThreshold * MAD_TO_SIGMA * mad;
+  result.name = name;
+  result.samples = 0;
+  for (int i = 0; i < count; i++)
+  {
+    if (mad == 0 || fabs(samples[i] - median) <= limit)
+      result.values[result.samples++] = samples[i];
+  }
+  result.outliers = count - result.samples;
+
+  double sum = 0;
+  for (int i = 0; i < result.samples; i++)
+    sum += result.values[i];
+  result.mean = result.samples ? sum / result.samples : 0;
+
+  memcpy(sorted, result.values, result.samples * sizeof(double));
+  result.median = selectMedian(sorted, result.samples);
+  for (int i = 0; i < result.samples; i++)
+    deviations[i] = fabs(result.values[i] - result.median);
+  result.mad = selectMedian(deviations, result.samples);
+
+  int resamples = config.bootstrapResamples > BENCH_MAX_BOOTSTRAP ? BENCH_MAX_BOOTSTRAP : config.bootstrapResamples;
+  if (result.samples < 2 || resamples < 1)
+  {
+    result.ciLow = result.ciHigh = result.median;
+    return;
+  }
+  uint32_t state = 0x9E3779B9u;
+  for (int i = 0; i < resamples; i++)
+    bootstrapBuffer[i] = (float)resampledMedian(result.values, result.samples, state);
+  bootstrapInterval(resamples, config.confidence, result.ciLow, result.ciHigh);
+}
+
+void benchRun(const char *name, BenchRoundFn round, void *context, const BenchConfig &config,
+              BenchResult &result, bool verbose)
+{
+  double samples[BENCH_MAX_ROUNDS];
+  int rounds = config.rounds > BENCH_MAX_ROUNDS ? BENCH_MAX_ROUNDS : config.rounds;
+
+  for (int i = 0; i < config.warmupRounds; i++)
+    round(context);
+
+  for (int i = 0; i < rounds; i++)
+  {
+    samples[i] = round(context);
+    if (verbose)
+      Serial.printf("  Round %d: %0.5f %s\n", i + 1, samples[i], config.unit);
+  }
+
+  benchSummarize(name, samples, rounds, config, result);
+}
+
+void benchPaired(const char *name, BenchRoundFn a, void *contextA, BenchRoundFn b, void *contextB,
+                 const BenchConfig &config, BenchResult &ratio)
+{
+  double samples[BENCH_MAX_ROUNDS];
+  int rounds = config.rounds > BENCH_MAX_ROUNDS ? BENCH_MAX_ROUNDS : config.rounds;
+
+  for (int i = 0; i < config.warmupRounds; i++)
+  {
+    a(contextA);
+    b(contextB);
+  }
+
+  for (int i = 0; i < rounds; i++)
+  {
+    double timeA;
+    double timeB;
+    if (i & 1)
+    {
+      timeB = b(contextB);
+      timeA = a(contextA);
+    }
+    else
+    {
+      timeA = a(contextA);
+      timeB = b(contextB);
+    }
+    samples[i] = timeB > 0 ? timeA / timeB : 0;
+  }
+
+  benchSummarize(name, samples, rounds, config, ratio);
+}
+
+bool benchIndistinguishable(const BenchResult &a, const BenchResult &b, const BenchConfig &config,
+                            double *diffLow, double *diffHigh)
+{
+  double low = a.median - b.median;
+  double high = low;
+  int resamples = config.bootstrapResamples > BENCH_MAX_BOOTSTRAP ? BENCH_MAX_BOOTSTRAP : config.bootstrapResamples;
+
+  if (a.samples >= 2 && b.samples >= 2 && resamples > 0)
+  {
+    uint32_t state = 0x2545F491u;
+    for (int i = 0; i < resamples; i++)
+      bootstrapBuffer[i] = (float)(resampledMedian(a.values, a.samples, state) -
+                                   resampledMedian(b.values, b.samples, state));
+    bootstrapInterval(resamples, config.confidence, low, high);
+  }
+
+  if (diffLow)
+    *diffLow = low;
+  if (diffHigh)
+    *diffHigh = high;
+  return low <= 0 && high >= 0;
+}
+
+int benchFastest(const BenchResult results[], int count)
+{
+  int fastest = 0;
+  for (int i = 1; i < count; i++)
+  {
+    if (results[i].median < results[fastest].median)
+      fastest = i;
+  }
+  return fastest;
+}
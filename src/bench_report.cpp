@@ -0,0 +1,111 @@
+#include "bench_report.h"
+
+#define BENCH_STRINGIFY2(x) #x
+#define BENCH_STRINGIFY(x) BENCH_STRINGIFY2(x)
+
+#if defined(__OPTIMIZE_SIZE__)
+#define BENCH_OPT_LEVEL "-Os"
+#elif defined(__OPTIMIZE__)
+#define BENCH_OPT_LEVEL "-O2"
+#else
+#define BENCH_OPT_LEVEL "-O0"
+#endif
+
+#if defined(BENCH_NATIVE)
+#define BENCH_TARGET "native"
+#else
+#define BENCH_TARGET "esp32"
+#endif
+
+// Compiler and the flags that change the generated code
+static const char buildFlags[] = BENCH_TARGET " gcc " __VERSION__ " " BENCH_OPT_LEVEL " -std=" BENCH_STRINGIFY(__cplusplus)
+#if defined(CORE_DEBUG_LEVEL)
+    " CORE_DEBUG_LEVEL=" BENCH_STRINGIFY(CORE_DEBUG_LEVEL)
+#endif
+    ;
+
+/**
+ * @brief Print str as a JSON string, escaped and streamed in chunks: no length limit
+ */
+static void printJsonString(const char *str)
+{
+  char chunk[64];
+  size_t out = 0;
+  chunk[out++] = '"';
+  for (; *str; str++)
+  {
+    if (out > sizeof(chunk) - 8) // Room for the longest escape (\u00XX) and the NUL
+    {
+      chunk[out] = '\0';
+      Serial.print(chunk);
+      out = 0;
+    }
+    unsigned char c = (unsigned char)*str;
+    if (c == '"' || c == '\\')
+    {
+      chunk[out++] = '\\';
+      chunk[out++] = (char)c;
+    }
+    else if (c < ' ')
+    {
+      out += snprintf(chunk + out, sizeof(chunk) - out, "\\u%04x", c);
+    }
+    else
+    {
+      chunk[out++] = (char)c;
+    }
+  }
+  chunk[out++] = '"';
+  chunk[out] = '\0';
+  Serial.print(chunk);
+}
+
+void benchRecord(const char *suite, const char *resolver, const char *path, const char *metric, double value,
+                 const char *unit, long iterations)
+{
+#if BENCH_RECORDS
+  Serial.print(BENCH_RECORD_PREFIX "{\"suite\":");
+  printJsonString(suite);
+  Serial.print(",\"resolver\":");
+  printJsonString(resolver);
+  Serial.print(",\"path\":");
+  printJsonString(path);
+  Serial.print(",\"metric\":");
+  printJsonString(metric);
+  if (isfinite(value))
+    Serial.printf(",\"value\":%0.6g,\"unit\":", value);
+  else
+    Serial.print(",\"value\":null,\"unit\":"); // nan and inf are not JSON
+  printJsonString(unit);
+  Serial.printf(",\"iterations\":%ld,\"cpu_mhz\":%u,\"chip\":", iterations, (unsigned)getCpuFrequencyMhz());
+  printJsonString(ESP.getChipModel());
+  Serial.printf(",\"revision\":%u,\"build\":", (unsigned)ESP.getChipRevision());
+  printJsonString(buildFlags);
+  Serial.println("}");
+#endif
+}
+
+static int failedChecks = 0;
+
+bool benchRequire(bool condition, const char *check)
+{
+  if (condition)
+  {
+    Serial.printf("✅ %s\n", check);
+  }
+  else
+  {
+    Serial.printf("❌ %s: FAILED\n", check);
+    failedChecks++;
+#if defined(BENCH_NATIVE)
+    hostSetExitStatus(1);
+#endif
+  }
+  benchRecord("check", "", check, "failed", condition ? 0 : 1, "bool");
+  return condition;
+}
+
+int benchFailedChecks()
+{
+  return failedChecks;
+}
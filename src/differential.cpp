@@ -0,0 +1,233 @@
+#include "differential.h"
+
+// Never a valid MIME type: left in _contentType when a resolver does not write it
+static const char staleContentType[] = "<stale>";
+
+static const char *const sweepPrefixes[] = {"", "/dir.js/file", "/static/app/v2/assets/vendor/dist/bundle"};
+static const char *const sweepSuffixes[] = {".gz", ".br", ".GZ", ".Br", ".gzip", ".b"};
+
+const char *referenceContentType(const char *path)
+{
+  const char *dot = strrchr(path, '.');
+  if (dot)
+  {
+    for (size_t i = 0; i < MIME_TABLE_SIZE; i++)
+    {
+      if (strcmp(dot, mimeTable[i].ext) == 0)
+        return mimeTable[i].mime;
+    }
+  }
+  return T_application_octet_stream;
+}
+
+const char *referenceContentTypeExtended(const char *path, ContentEncoding &encoding)
+{
+  char folded[DIFF_MAX_PATH + 1];
+  size_t len = strlen(path);
+  len = len > DIFF_MAX_PATH ? DIFF_MAX_PATH : len;
+  for (size_t i = 0; i < len; i++)
+    folded[i] = (path[i] >= 'A' && path[i] <= 'Z') ? (char)(path[i] + ('a' - 'A')) : path[i];
+  folded[len] = '\0';
+
+  encoding = ENCODING_IDENTITY;
+  const char *mime = referenceContentType(folded);
+  if (mime != T_application_octet_stream)
+    return mime;
+
+  const char *dot = strrchr(folded, '.');
+  ContentEncoding suffix = !dot                      ? ENCODING_IDENTITY
+                           : strcmp(dot, ".gz") == 0 ? ENCODING_GZIP
+                           : strcmp(dot, ".br") == 0 ? ENCODING_BROTLI
+                                                     : ENCODING_IDENTITY;
+  if (suffix == ENCODING_IDENTITY)
+    return mime;
+
+  folded[dot - folded] = '\0';
+  mime = referenceContentType(folded);
+  if (mime != T_application_octet_stream)
+    encoding = suffix;
+  return mime;
+}
+
+int checkResolvers(const char *path, size_t len, DifferentialStats &stats)
+{
+  char buffer[DIFF_MAX_PATH + 1];
+  len = len > DIFF_MAX_PATH ? DIFF_MAX_PATH : len;
+  memcpy(buffer, path, len);
+  buffer[len] = '\0';
+  String input(buffer);
+
+  ContentEncoding expectedEncoding;
+  const char *expected = referenceContentType(buffer);
+  const char *expectedExtended = referenceContentTypeExtended(buffer, expectedEncoding);
+
+  int mismatches = 0;
+  stats.paths++;
+  for (int v = 0; v < resolverCount(); v++)
+  {
+    const ResolverCandidate &candidate = resolverAt(v);
+    bool extended = candidate.flags & RESOLVER_EXTENDED_SEMANTICS;
+
+    _contentType = staleContentType;
+    _contentEncoding = ENCODING_IDENTITY;
+    candidate.func(input);
+
+    const char *want = extended ? expectedExtended : expected;
+    bool match = _contentType && _contentType != staleContentType && strcmp(_contentType, want) == 0 &&
+                 (!extended || _contentEncoding == expectedEncoding);
+    if (match)
+      continue;
+
+    mismatches++;
+    stats.perResolver[v]++;
+    if (stats.mismatches++ < DIFF_REPORT_LIMIT)
+    {
+      Serial.printf("MISMATCH %s: \"%s\" -> %s (encoding %d), expected %s (encoding %d)\n", candidate.name, buffer,
+                    _contentType ? _contentType : "(null)", _contentEncoding, want,
+                    extended ? expectedEncoding : ENCODING_IDENTITY);
+    }
+  }
+  return mismatches;
+}
+
+// ========================================
+// EXHAUSTIVE SWEEP
+// ========================================
+
+#define SWEEP_ALPHABET_MAX 64
+
+struct SweepAlphabet
+{
+  char chars[DIFF_SWEEP_MAX_LEN][SWEEP_ALPHABET_MAX];
+  int size[DIFF_SWEEP_MAX_LEN];
+};
+
+static void addSweepChar(SweepAlphabet &alphabet, int position, char c)
+{
+  for (int i = 0; i < alphabet.size[position]; i++)
+  {
+    if (alphabet.chars[position][i] == c)
+      return;
+  }
+  if (alphabet.size[position] < SWEEP_ALPHABET_MAX)
+    alphabet.chars[position][alphabet.size[position]++] = c;
+}
+
+static void buildSweepAlphabet(SweepAlphabet &alphabet)
+{
+  for (int position = 0; position < DIFF_SWEEP_MAX_LEN; position++)
+  {
+    alphabet.size[position] = 0;
+    for (size_t i = 0; i < MIME_TABLE_SIZE; i++)
+    {
+      const char *ext = mimeTable[i].ext + 1;
+      if (strlen(ext) <= (size_t)position)
+        continue;
+      char c = ext[position];
+      addSweepChar(alphabet, position, c);
+      if (c >= 'a' && c <= 'z')
+        addSweepChar(alphabet, position, (char)(c - ('a' - 'A')));
+    }
+    addSweepChar(alphabet, position, 'z');
+    addSweepChar(alphabet, position, '.');
+    addSweepChar(alphabet, position, '/');
+  }
+}
+
+/**
+ * @brief Check prefix + "." + every extension of length chars, odometer style
+ */
+static void sweepLength(const SweepAlphabet &alphabet, int length, DifferentialStats &stats)
+{
+  int digit[DIFF_SWEEP_MAX_LEN] = {};
+  char path[DIFF_MAX_PATH + 1];
+
+  for (const char *prefix : sweepPrefixes)
+  {
+    size_t prefixLen = strlen(prefix);
+    memcpy(path, prefix, prefixLen);
+    path[prefixLen] = '.';
+    char *ext = path + prefixLen + 1;
+    ext[length] = '\0';
+
+    for (int i = 0; i < length; i++)
+      digit[i] = 0;
+    while (true)
+    {
+      for (int i = 0; i < length; i++)
+        ext[i] = alphabet.chars[i][digit[i]];
+      checkResolvers(path, prefixLen + 1 + length, stats);
+
+      int position = length - 1;
+      while (position >= 0 && ++digit[position] == alphabet.size[position])
+        digit[position--] = 0;
+      if (position < 0)
+        break;
+    }
+  }
+}
+
+void runExhaustiveSweep(DifferentialStats &stats)
+{
+  static SweepAlphabet alphabet;
+  char path[DIFF_MAX_PATH + 1];
+
+  buildSweepAlphabet(alphabet);
+  for (int length = 1; length <= DIFF_SWEEP_MAX_LEN; length++)
+  {
+    sweepLength(alphabet, length, stats);
+  }
+
+  // Pre-compressed variants of every known extension, lower and upper case
+  for (size_t i = 0; i < MIME_TABLE_SIZE; i++)
+  {
+    for (const char *suffix : sweepSuffixes)
+    {
+      for (int upper = 0; upper < 2; upper++)
+      {
+        int len = snprintf(path, sizeof(path), "/file%s%s", mimeTable[i].ext, suffix);
+        for (int c = 5; upper && c < len; c++)
+          path[c] = (path[c] >= 'a' && path[c] <= 'z') ? (char)(path[c] - ('a' - 'A')) : path[c];
+        checkResolvers(path, (size_t)len, stats);
+      }
+    }
+  }
+}
+
+// ========================================
+// RANDOM PATHS
+// ========================================
+
+static uint32_t nextRandom(uint32_t &state)
+{
+  state ^= state << 13;
+  state ^= state >> 17;
+  state ^= state << 5;
+  return state;
+}
+
+void runRandomPaths(uint32_t count, uint32_t seed, DifferentialStats &stats)
+{
+  static const char *const fragments[] = {"/", ".", "a", "Z", "js", "HTML", "htm", "css", "json", "png", "woff",
+                                          "2", "gz", "br", "webp", "m", "txt", "?", "x", "..", "/.", ".tar"};
+  static const int fragmentCount = sizeof(fragments) / sizeof(fragments[0]);
+  char path[DIFF_MAX_PATH + 1];
+  uint32_t state = seed | 1;
+
+  for (uint32_t n = 0; n < count; n++)
+  {
+    size_t len = 0;
+    int pieces = (int)(nextRandom(state) % 8);
+    for (int i = 0; i < pieces; i++)
+    {
+      const char *fragment = fragments[nextRandom(state) % fragmentCount];
+      size_t fragmentLen = strlen(fragment);
+      if (len + fragmentLen > DIFF_MAX_PATH)
+        break;
+      memcpy(path + len, fragment, fragmentLen);
+      len += fragmentLen;
+    }
+    path[len] = '\0';
+    checkResolvers(path, len, stats);
+  }
+}
@@ -0,0 +1,189 @@
+#include "footprint.h"
+#include "mime_types.h"
+
+#include <atomic>
+
+#if defined(BENCH_NATIVE)
+#include <pthread.h>
+#else
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#endif
+
+// ========================================
+// MALLOC HOOK
+// ========================================
+
+static std::atomic<uint32_t> allocations(0);
+
+extern "C"
+{
+  // Weak: without the --wrap flags nothing calls the wrappers and these stay unresolved
+  void *__real_malloc(size_t size) __attribute__((weak));
+  void *__real_calloc(size_t count, size_t size) __attribute__((weak));
+  void *__real_realloc(void *ptr, size_t size) __attribute__((weak));
+
+  void *__wrap_malloc(size_t size)
+  {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    return __real_malloc(size);
+  }
+
+  void *__wrap_calloc(size_t count, size_t size)
+  {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    return __real_calloc(count, size);
+  }
+
+  void *__wrap_realloc(void *ptr, size_t size)
+  {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    return __real_realloc(ptr, size);
+  }
+}
+
+uint32_t heapAllocationCount()
+{
+  return allocations.load(std::memory_order_relaxed);
+}
+
+bool heapHookActive()
+{
+  uint32_t before = heapAllocationCount();
+  void *volatile probe = malloc(1);
+  free(probe);
+  return heapAllocationCount() != before;
+}
+
+// ========================================
+// ISOLATED STACK MEASUREMENT
+// ========================================
+
+#define STACK_PAINT 0xA5 // Also the FreeRTOS fill byte
+
+#if defined(__XTENSA__)
+#define STACK_SAVE_AREA 16 // Below sp: window overflow spills the registers of the current frame there
+#else
+#define STACK_SAVE_AREA 0
+#endif
+
+struct StackProbe
+{
+  ResolverFn func;
+  const String *paths;
+  int pathCount;
+  uint8_t *stackLow; // Lowest address of the stack the probe runs on
+  size_t used;       // Bytes
+#if !defined(BENCH_NATIVE)
+  SemaphoreHandle_t done;
+#endif
+};
+
+/**
+ * @brief Current stack pointer
+ */
+static inline __attribute__((always_inline)) uint8_t *stackPointer()
+{
+  uint8_t *sp;
+#if defined(__x86_64__)
+  asm volatile("mov %%rsp, %0" : "=r"(sp));
+#elif defined(__i386__)
+  asm volatile("mov %%esp, %0" : "=r"(sp));
+#elif defined(__XTENSA__)
+  asm volatile("mov %0, a1" : "=r"(sp));
+#else
+  sp = (uint8_t *)__builtin_frame_address(0); // Above sp: overstates by the probe's own frame
+#endif
+  return sp;
+}
+
+/**
+ * @brief Paint the free stack below this frame, run the resolver over all paths, find the deepest byte written
+ * @note Painting and scanning are inline loops without calls, so nothing but the
+ *       resolver runs below the marker and thread or task start-up is not counted.
+ *       The stack grows down.
+ */
+static void __attribute__((noinline)) runProbe(StackProbe &probe)
+{
+  uint8_t *marker = stackPointer() - STACK_SAVE_AREA;
+  for (volatile uint8_t *p = probe.stackLow; p < marker; p++)
+    *p = STACK_PAINT;
+
+  for (int i = 0; i < probe.pathCount; i++)
+  {
+    probe.func(probe.paths[i]);
+    asm volatile("" ::"m"(_contentType) : "memory");
+  }
+
+  const volatile uint8_t *deepest = probe.stackLow;
+  while (deepest < marker && *deepest == STACK_PAINT)
+    deepest++;
+  probe.used = (size_t)(marker - (const uint8_t *)deepest);
+}
+
+#if defined(BENCH_NATIVE)
+
+#define HOST_PROBE_STACK (256 * 1024) // glibc keeps the thread descriptor and TLS at the top of it
+
+static void *probeThread(void *arg)
+{
+  runProbe(*(StackProbe *)arg);
+  return nullptr;
+}
+
+/**
+ * @brief Run the probe on a thread with a stack of known bounds
+ */
+static size_t stackUsedBy(StackProbe &probe)
+{
+  static uint8_t stack[HOST_PROBE_STACK] __attribute__((aligned(64)));
+
+  pthread_attr_t attr;
+  pthread_t thread;
+  probe.stackLow = stack;
+  pthread_attr_init(&attr);
+  pthread_attr_setstack(&attr, stack, sizeof(stack));
+  if (pthread_create(&thread, &attr, probeThread, &probe) != 0)
+  {
+    pthread_attr_destroy(&attr);
+    return 0;
+  }
+  pthread_join(thread, nullptr);
+  pthread_attr_destroy(&attr);
+  return probe.used;
+}
+
+#else
+
+static void probeTask(void *arg)
+{
+  StackProbe &probe = *(StackProbe *)arg;
+  probe.stackLow = pxTaskGetStackStart(NULL);
+  runProbe(probe);
+  xSemaphoreGive(probe.done);
+  vTaskDelete(NULL);
+}
+
+/**
+ * @brief Run the probe in a fresh task on the current core
+ */
+static size_t stackUsedBy(StackProbe &probe)
+{
+  probe.done = xSemaphoreCreateBinary();
+  if (xTaskCreatePinnedToCore(probeTask, "stackProbe", FOOTPRINT_TASK_STACK, &probe, uxTaskPriorityGet(NULL), NULL,
+                              xPortGetCoreID()) == pdPASS)
+  {
+    xSemaphoreTake(probe.done, portMAX_DELAY);
+  }
+  vSemaphoreDelete(probe.done);
+  return probe.used;
+}
+
+#endif
+
+size_t measureStackDepth(ResolverFn func, const String paths[], int pathCount)
+{
+  StackProbe probe = {func, paths, pathCount, nullptr, 0};
+  return stackUsedBy(probe);
+}
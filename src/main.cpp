@@ -1,64 +1,79 @@
 #include <Arduino.h>
 #include <esp_timer.h>
+#include "access_trace.h"
+#include "adaptive_resolver.h"
+#include "bench_engine.h"
+#include "bench_report.h"
+#include "cycle_timer.h"
+#include "differential.h"
+#include "footprint.h"
+#include "latency_histogram.h"
+#include "mime_batch.h"
+#include "mime_dfa.h"
+#include "mime_hash.h"
+#include "mime_registry.h"
+#include "mime_types.h"
+#include "parallel_bench.h"
+#include "path_cache.h"
+#include "placement_study.h"
+#include "resolver_registry.h"
+#include "resolver_telemetry.h"
+#include "workload.h"
 
 
+// Global variable to simulate contentType pointer
+const char *_contentType = nullptr;
+ContentEncoding _contentEncoding = ENCODING_IDENTITY;
+
 // ========================================
-// MOCK DEFINITIONS
+// PACKED EXTENSIONS (generated at compile time)
 // ========================================
 
-// extensions & MIME-Types
-static constexpr const char *T__avif = ".avif";                                   // AVIF: Highly compressed images. Compatible with all modern browsers.
-static constexpr const char *T__csv = ".csv";                                     // CSV: Data logging and configuration
-static constexpr const char *T__css = ".css";                                     // CSS: Styling for web interfaces
-static constexpr const char *T__gif = ".gif";                                     // GIF: Simple animations. Legacy support
-static constexpr const char *T__gz = ".gz";                                       // GZ: compressed files
-static constexpr const char *T__htm = ".htm";                                     // HTM: Web interface files
-static constexpr const char *T__html = ".html";                                   // HTML: Web interface files
-static constexpr const char *T__ico = ".ico";                                     // ICO: Favicons, system icons. Legacy support
-static constexpr const char *T__jpg = ".jpg";                                     // JPEG/JPG: Photos. Legacy support
-static constexpr const char *T__js = ".js";                                       // JavaScript: Interactive functionality
-static constexpr const char *T__json = ".json";                                   // JSON: Data exchange format
-static constexpr const char *T__mp4 = ".mp4";                                     // MP4: Proprietary format. Worse compression than WEBM.
-static constexpr const char *T__opus = ".opus";                                   // OPUS: High compression audio format
-static constexpr const char *T__pdf = ".pdf";                                     // PDF: Universal document format
-static constexpr const char *T__png = ".png";                                     // PNG: Icons, logos, transparency. Legacy support
-static constexpr const char *T__svg = ".svg";                                     // SVG: Vector graphics, icons (scalable, tiny file sizes)
-static constexpr const char *T__ttf = ".ttf";                                     // TTF: Font file. Legacy support
-static constexpr const char *T__txt = ".txt";                                     // TXT: Plain text files
-static constexpr const char *T__webm = ".webm";                                   // WebM: Video. Open source, optimized for web. Compatible with all modern browsers.
-static constexpr const char *T__webp = ".webp";                                   // WebP: Highly compressed images. Compatible with all modern browsers.
-static constexpr const char *T__woff = ".woff";                                   // WOFF: Font file. Legacy support
-static constexpr const char *T__woff2 = ".woff2";                                 // WOFF2: Better compression. Compatible with all modern browsers.
-static constexpr const char *T__xml = ".xml";                                     // XML: Configuration and data files
-static constexpr const char *T_application_javascript = "application/javascript"; // Obsolete type for JavaScript
-static constexpr const char *T_application_json = "application/json";
-static constexpr const char *T_application_msgpack = "application/msgpack";
-static constexpr const char *T_application_octet_stream = "application/octet-stream";
-static constexpr const char *T_application_pdf = "application/pdf";
-static constexpr const char *T_app_xform_urlencoded = "application/x-www-form-urlencoded";
-static constexpr const char *T_audio_opus = "audio/opus";
-static constexpr const char *T_font_ttf = "font/ttf";
-static constexpr const char *T_font_woff = "font/woff";
-static constexpr const char *T_font_woff2 = "font/woff2";
-static constexpr const char *T_image_avif = "image/avif";
-static constexpr const char *T_image_gif = "image/gif";
-static constexpr const char *T_image_jpeg = "image/jpeg";
-static constexpr const char *T_image_png = "image/png";
-static constexpr const char *T_image_svg_xml = "image/svg+xml";
-static constexpr const char *T_image_webp = "image/webp";
-static constexpr const char *T_image_x_icon = "image/x-icon";
-static constexpr const char *T_text_css = "text/css";
-static constexpr const char *T_text_csv = "text/csv";
-static constexpr const char *T_text_event_stream = "text/event-stream";
-static constexpr const char *T_text_html = "text/html";
-static constexpr const char *T_text_javascript = "text/javascript";
-static constexpr const char *T_text_plain = "text/plain";
-static constexpr const char *T_text_xml = "text/xml";
-static constexpr const char *T_video_mp4 = "video/mp4";
-static constexpr const char *T_video_webm = "video/webm";
+/**
+ * @brief Extension characters after the dot, packed little-endian and zero padded
+ * @return 0 when the extension is empty or longer than 8 characters
+ */
+static constexpr uint64_t packExtension(const char *ext)
+{
+  uint64_t key = 0;
+  for (unsigned i = 0; i < 8; i++)
+  {
+    if (!ext[i])
+      return key;
+    key |= (uint64_t)(uint8_t)ext[i] << (8 * i);
+  }
+  return ext[8] ? 0 : key;
+}
+
+struct PackedMimeEntry
+{
+  uint64_t key;
+  const char *mime;
+};
 
-// Global variable to simulate contentType pointer
-const char *_contentType = nullptr;
+struct PackedMimeTable
+{
+  PackedMimeEntry entries[MIME_TABLE_SIZE];
+};
+
+/**
+ * @brief mimeTable keyed by packExtension() and sorted by key
+ */
+static constexpr PackedMimeTable buildPackedMimeTable()
+{
+  PackedMimeTable table = {};
+  for (size_t i = 0; i < MIME_TABLE_SIZE; i++)
+  {
+    PackedMimeEntry entry = {packExtension(mimeTable[i].ext + 1), mimeTable[i].mime};
+    size_t j = i;
+    for (; j > 0 && table.entries[j - 1].key > entry.key; j--)
+      table.entries[j] = table.entries[j - 1];
+    table.entries[j] = entry;
+  }
+  return table;
+}
+
+static constexpr PackedMimeTable packedMimeTable = buildPackedMimeTable();
 
 // ========================================
 // FUNCTIONS TO BENCHMARK
@@ -163,6 +178,8 @@ void _setContentTypeFromPath_v1(const String &path)
   }
 }
 
+REGISTER_RESOLVER(_setContentTypeFromPath_v1, "Version 1", 1);
+
 /**
  * @brief Optimized version using switch
  */
@@ -176,6 +193,8 @@ void _setContentTypeFromPath_v2(const String &path) {
     return;
   }
 
+  // Cleared so the fallback below catches a known first letter with an unknown extension
+  _contentType = nullptr;
   switch (dot[1]) {
   case 'a':
     if (strcmp(dot, T__avif) == 0)
@@ -258,6 +277,8 @@ void _setContentTypeFromPath_v2(const String &path) {
   }
 }
 
+REGISTER_RESOLVER(_setContentTypeFromPath_v2, "Version 2", 2);
+
 #define EXT_EQ(dot, ext) (dot[1] == ext[1] && strcmp(dot, ext) == 0)
 /**
  * @brief Optimized version using table
@@ -310,6 +331,244 @@ void _setContentTypeFromPath_v3(const String &path) {
     _contentType = T_application_octet_stream;
 }
 
+REGISTER_RESOLVER(_setContentTypeFromPath_v3, "Version 3", 3);
+
+/**
+ * @brief Optimized version using compile-time perfect hash
+ */
+void _setContentTypeFromPath_v4(const String &path)
+{
+  const char *dot = strrchr(path.c_str(), '.');
+  size_t len = dot ? strlen(dot) : 0;
+  if (len < 2 || len > MIME_EXT_MAX_LEN)
+  {
+    _contentType = T_application_octet_stream;
+    return;
+  }
+
+  const MimeSlot &slot = mimeHashTable.slots[mimeHash(dot[1], dot[len - 1], len, MIME_HASH_SEED)];
+  if (slot.len == len && memcmp(dot, slot.ext, len) == 0)
+    _contentType = slot.mime;
+  else
+    _contentType = T_application_octet_stream;
+}
+
+REGISTER_RESOLVER(_setContentTypeFromPath_v4, "Version 4", 4);
+
+/**
+ * @brief Optimized version comparing the extension as a single 64-bit integer
+ */
+void _setContentTypeFromPath_v5(const String &path)
+{
+  const char *dot = strrchr(path.c_str(), '.');
+  if (!dot)
+  {
+    _contentType = T_application_octet_stream;
+    return;
+  }
+  uint64_t key = packExtension(dot + 1);
+
+  // Branchless binary search over the sorted keys
+  const PackedMimeEntry *base = packedMimeTable.entries;
+  size_t n = MIME_TABLE_SIZE;
+  while (n > 1)
+  {
+    size_t half = n / 2;
+    base = (base[half].key <= key) ? base + half : base;
+    n -= half;
+  }
+  _contentType = (base->key == key) ? base->mime : T_application_octet_stream;
+}
+
+REGISTER_RESOLVER(_setContentTypeFromPath_v5, "Version 5", 5);
+
+/**
+ * @brief Perfect hash version built on the bounded reverse scan of findExtension()
+ * @note Reads only [path, path + pathLen): a slice of a request buffer works without a copy
+ */
+void _setContentTypeFromPath_v8(const char *path, size_t pathLen)
+{
+  const char *dot = findExtension(path, pathLen);
+  size_t len = dot ? (size_t)(path + pathLen - dot) : 0;
+  if (len < 2)
+  {
+    _contentType = T_application_octet_stream;
+    return;
+  }
+
+  const MimeSlot &slot = mimeHashTable.slots[mimeHash(dot[1], dot[len - 1], len, MIME_HASH_SEED)];
+  if (slot.len == len && memcmp(dot, slot.ext, len) == 0)
+    _contentType = slot.mime;
+  else
+    _contentType = T_application_octet_stream;
+}
+
+void _setContentTypeFromPath_v8(const String &path)
+{
+  _setContentTypeFromPath_v8(path.c_str(), path.length());
+}
+
+REGISTER_RESOLVER(_setContentTypeFromPath_v8, "Version 8", 8);
+
+/**
+ * @brief ASCII lower case, other bytes unchanged
+ */
+static inline char foldCase(char c)
+{
+  return (c >= 'A' && c <= 'Z') ? (char)(c + ('a' - 'A')) : c;
+}
+
+/**
+ * @brief Case-insensitive compare of len bytes against a lower case extension
+ */
+static inline bool extensionEqualsIgnoreCase(const char *dot, const char *ext, size_t len)
+{
+  for (size_t i = 0; i < len; i++)
+  {
+    if (foldCase(dot[i]) != ext[i])
+      return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Case-insensitive perfect hash lookup of the extension [dot, dot + len)
+ * @return nullptr when the extension is unknown
+ */
+static inline const char *lookupExtensionIgnoreCase(const char *dot, size_t len)
+{
+  if (len < 2)
+    return nullptr;
+
+  const MimeSlot &slot = mimeHashTable.slots[mimeHash(foldCase(dot[1]), foldCase(dot[len - 1]), len, MIME_HASH_SEED)];
+  if (slot.len != len)
+    return nullptr;
+  // Lower case fast path, then the folded compare
+  if (memcmp(dot, slot.ext, len) == 0 || extensionEqualsIgnoreCase(dot, slot.ext, len))
+    return slot.mime;
+  return nullptr;
+}
+
+/**
+ * @brief Exact compare of len bytes, two overlapping loads per side up to 8 bytes
+ * @note Reads only [a, a + len) and [b, b + len); no library call for the usual extension lengths
+ */
+static inline bool extensionEqualsShort(const char *a, const char *b, size_t len)
+{
+  if (len >= 4 && len <= 8)
+  {
+    uint32_t a0, a1, b0, b1;
+    memcpy(&a0, a, 4);
+    memcpy(&a1, a + len - 4, 4);
+    memcpy(&b0, b, 4);
+    memcpy(&b1, b + len - 4, 4);
+    return ((a0 ^ b0) | (a1 ^ b1)) == 0;
+  }
+  if (len >= 2 && len < 4)
+  {
+    uint16_t a0, a1, b0, b1;
+    memcpy(&a0, a, 2);
+    memcpy(&a1, a + len - 2, 2);
+    memcpy(&b0, b, 2);
+    memcpy(&b1, b + len - 2, 2);
+    return ((a0 ^ b0) | (a1 ^ b1)) == 0;
+  }
+  return memcmp(a, b, len) == 0;
+}
+
+/**
+ * @brief Slow path of Version 9: folded lookup, then the .gz / .br suffix
+ * @param len Length of the extension at dot, 0 when the path has none
+ */
+static void __attribute__((noinline)) setContentTypeFolded(const char *cpath, const char *dot, size_t len)
+{
+  const char *mime = lookupExtensionIgnoreCase(dot, len);
+  if (!mime && len == 3)
+  {
+    ContentEncoding encoding = ENCODING_IDENTITY;
+    if (foldCase(dot[1]) == 'g' && foldCase(dot[2]) == 'z')
+      encoding = ENCODING_GZIP;
+    else if (foldCase(dot[1]) == 'b' && foldCase(dot[2]) == 'r')
+      encoding = ENCODING_BROTLI;
+
+    if (encoding != ENCODING_IDENTITY)
+    {
+      size_t innerPathLen = (size_t)(dot - cpath);
+      const char *innerDot = findExtension(cpath, innerPathLen);
+      mime = lookupExtensionIgnoreCase(innerDot, innerDot ? (size_t)(cpath + innerPathLen - innerDot) : 0);
+      _contentEncoding = mime ? encoding : ENCODING_IDENTITY;
+    }
+  }
+  _contentType = mime ? mime : T_application_octet_stream;
+}
+
+/**
+ * @brief Case-insensitive version with .gz / .br pre-compressed suffixes
+ * @note "/app.js.gz" gives the JavaScript type and ENCODING_GZIP. When the
+ *       inner extension is unknown ("/backup.tar.gz") the file is served as is:
+ *       application/octet-stream with ENCODING_IDENTITY.
+ *       A lower case extension without a suffix takes the Version 8 lookup
+ *       and returns before any folding.
+ */
+void _setContentTypeFromPath_v9(const String &path)
+{
+  const char *cpath = path.c_str();
+  size_t pathLen = path.length();
+  const char *dot = findExtension(cpath, pathLen);
+  size_t len = dot ? (size_t)(cpath + pathLen - dot) : 0;
+
+  _contentEncoding = ENCODING_IDENTITY;
+  if (len >= 2)
+  {
+    const MimeSlot &slot = mimeHashTable.slots[mimeHash(dot[1], dot[len - 1], len, MIME_HASH_SEED)];
+    if (slot.len == len && extensionEqualsShort(dot, slot.ext, len))
+    {
+      _contentType = slot.mime;
+      return;
+    }
+  }
+  setContentTypeFolded(cpath, dot, len);
+}
+
+REGISTER_RESOLVER_FLAGS(_setContentTypeFromPath_v9, "Version 9", 9, RESOLVER_EXTENDED_SEMANTICS);
+
+/**
+ * @brief Legacy setter wrapping the return-value API contentTypeFor()
+ */
+void _setContentTypeFromPath_v10(const String &path)
+{
+  _contentType = contentTypeFor(path.c_str(), path.length());
+}
+
+/**
+ * @brief Version 10 on a (pointer, length) view, which need not be NUL terminated
+ */
+void _setContentTypeFromPath_v10(const char *path, size_t len)
+{
+  _contentType = contentTypeFor(path, len);
+}
+
+REGISTER_RESOLVER(_setContentTypeFromPath_v10, "Version 10", 10);
+
+/**
+ * @brief Compile-time DFA over the extension bytes (include/mime_dfa.h), no compare
+ */
+void _setContentTypeFromPath_v11(const String &path)
+{
+  const char *dot = findExtension(path.c_str(), path.length());
+  _contentType = mimeTypeOf(dot ? mimeDfaIndex(dot + 1) : (uint8_t)MIME_INDEX_NONE);
+}
+
+/**
+ * @brief Version 11 on a (pointer, length) view: the DFA stops at the end of the view instead of a NUL
+ */
+void _setContentTypeFromPath_v11(const char *path, size_t len)
+{
+  const char *dot = findExtension(path, len);
+  _contentType = mimeTypeOf(dot ? mimeDfaIndex(dot + 1, (size_t)(path + len - dot - 1)) : (uint8_t)MIME_INDEX_NONE);
+}
+
+REGISTER_RESOLVER(_setContentTypeFromPath_v11, "Version 11", 11);
 
 // ========================================
 // BENCHMARK CONFIGURATION
@@ -317,7 +576,60 @@ void _setContentTypeFromPath_v3(const String &path) {
 
 #define BENCHMARK_ITERATIONS 100000 // Number of iterations per test
 #define BENCHMARK_ROUNDS 10         // Number of test rounds for averaging
+#define BENCHMARK_WARMUP_ROUNDS 2   // Rounds run and discarded before measuring
+#define BENCHMARK_BOOTSTRAP 1000    // Bootstrap resamples for confidence intervals
+#define BENCHMARK_CONFIDENCE 0.95   // Confidence level used for intervals and verdicts
+#define BENCHMARK_OUTLIER_MADS 3.0  // Rounds further than this many sigmas (from MAD) are rejected
+#define WORKLOAD_ZIPF_EXPONENT 1.1  // Skew of the synthetic Zipf workload
+#define WORKLOAD_SEED 12345         // Seed of the synthetic workloads
+#define WORKLOAD_PHASES 4           // Popularity changes of the shifting workload
+
+// Deep paths and REST style URLs with query strings, for the extension scan cost
+#define DEEP_PATH_COUNT 10
+static const char *deepPaths[DEEP_PATH_COUNT] = {
+    "/static/app/v2/assets/vendor/bootstrap/dist/css/bootstrap.min.css",
+    "/static/app/v2/assets/vendor/chart.js/dist/chart.umd.min.js",
+    "/static/app/v2/assets/images/backgrounds/dashboard/night/large.webp",
+    "/static/app/v2/assets/fonts/inter/latin-ext/inter-var-latin-ext.woff2",
+    "/api/v1/devices/esp32-s3-a1b2c3/sensors/temperature/history.json",
+    "/api/v1/devices/esp32-s3-a1b2c3/status.json?fields=rssi,heap,uptime&ts=1760688000",
+    "/api/v1/logs/download.txt?from=2026-10-01T00:00:00Z&to=2026-10-17T23:59:59Z",
+    "/api/v1/devices/esp32-s3-a1b2c3/config?format=json&include=network,ota,mqtt",
+    "/ota/firmware/releases/2026.10.1/esp32s3/lolin_s3_mini/firmware.bin",
+    "/static/app/v2/index.html?utm_source=newsletter&utm_medium=email&utm_campaign=october",
+};
+
+// Optional recorded trace: LittleFS file on the ESP32, BENCH_TRACE environment variable on the host
+#define TRACE_FILE "/trace.log"
 #define TEST_DATA_SIZE 25           // Number of different test patterns
+#define SWEEP_FREQUENCIES_MHZ {80, 160, 240} // CPU clocks of the frequency sweep, setCpuFrequencyMhz() values
+#define SWEEP_MAX_STEPS 4
+#define DIFF_RANDOM_PATHS 100000    // Random paths of the differential check
+#define MEMORY_TEST_CALLS 1000      // Calls per version when counting heap allocations
+#define BATCH_SIZE 256              // Paths per mimeIndicesFor() call, e.g. one directory listing
+#define REQUEST_HEAD_BYTES 64       // Request head around one trace path, NUL included
+#define REQUEST_BUFFER_SIZE (ACCESS_TRACE_PATH_BYTES + ACCESS_TRACE_PATHS * REQUEST_HEAD_BYTES) // Simulated request loop
+#define TELEMETRY_REPORT_INTERVAL_MS 30000 // Period of the telemetry report printed from loop()
+
+// Extra MIME types for the runtime registry: LittleFS file on the ESP32, BENCH_MIME_TYPES environment variable on the host
+#define MIME_TYPES_FILE "/mime.types"
+#define REGISTRY_PROBE_PATHS TEST_DATA_SIZE // Paths per lookup class in the registry growth benchmark
+
+// What the timed region of benchmarkFunction() contains
+enum BenchmarkMode
+{
+  BENCH_LOOKUP_ONLY, // Resolver call only, paths pre-built as String
+  BENCH_END_TO_END   // String construction (malloc/strlen/memcpy/free) + resolver call
+};
+
+static const BenchConfig benchConfig = {
+    BENCHMARK_WARMUP_ROUNDS,
+    BENCHMARK_ROUNDS,
+    BENCHMARK_BOOTSTRAP,
+    BENCHMARK_CONFIDENCE,
+    BENCHMARK_OUTLIER_MADS,
+    "μs per call",
+};
 
 // Test data patterns - realistic file paths
 static const char *testPaths[TEST_DATA_SIZE] = {
@@ -360,6 +672,27 @@ static inline uint64_t getMicros()
   return esp_timer_get_time();
 }
 
+// testPaths[] as String objects, built once so the timed loop does not allocate
+static String testStrings[TEST_DATA_SIZE];
+static size_t testPathLengths[TEST_DATA_SIZE];
+static size_t accessTraceLengths[ACCESS_TRACE_PATHS];
+
+/**
+ * @brief Build testStrings[] and testPathLengths[] from testPaths[], accessTraceLengths[] from accessTracePaths[]
+ */
+void prepareTestStrings()
+{
+  for (int i = 0; i < TEST_DATA_SIZE; i++)
+  {
+    testStrings[i] = testPaths[i];
+    testPathLengths[i] = strlen(testPaths[i]);
+  }
+  for (int i = 0; i < ACCESS_TRACE_PATHS; i++)
+  {
+    accessTraceLengths[i] = strlen(accessTracePaths[i]);
+  }
+}
+
 /**
  * @brief Verify that all functions produce identical results
  */
@@ -367,140 +700,1133 @@ bool verifyFunctionEquivalence()
 {
   Serial.println("=== VERIFYING FUNCTION EQUIVALENCE ===");
 
+  const char *results[RESOLVER_REGISTRY_MAX];
+  int count = resolverCount();
+
   for (int i = 0; i < TEST_DATA_SIZE; i++)
   {
     String testPath = String(testPaths[i]);
 
-    // Test version 1
-    _setContentTypeFromPath_v1(testPath);
-    const char *result1 = _contentType;
-
-    // Test version 2
-    _setContentTypeFromPath_v2(testPath);
-    const char *result2 = _contentType;
-
-    // Test version 3
-    _setContentTypeFromPath_v3(testPath);
-    const char *result3 = _contentType;
+    // Test every registered version
+    bool match = true;
+    for (int v = 0; v < count; v++)
+    {
+      resolverAt(v).func(testPath);
+      results[v] = _contentType;
+      match = match && strcmp(results[0], results[v]) == 0;
+    }
 
     // Compare results
-    if (strcmp(result1, result2) != 0 || strcmp(result1, result3) != 0)
+    if (!match)
     {
       Serial.printf("MISMATCH at test %d: %s\n", i, testPaths[i]);
-      Serial.printf("Version 1: %s\n", result1);
-      Serial.printf("Version 2: %s\n", result2);
-      Serial.printf("Version 3: %s\n", result3);
+      for (int v = 0; v < count; v++)
+      {
+        Serial.printf("%s: %s\n", resolverAt(v).name, results[v]);
+      }
       return false;
     }
 
-    Serial.printf("Test %d OK: %s -> %s\n", i, testPaths[i], result1);
+    Serial.printf("Test %d OK: %s -> %s\n", i, testPaths[i], results[0]);
   }
 
-  Serial.println("All functions produce identical results!\n");
+  Serial.printf("All %d functions produce identical results!\n\n", count);
   return true;
 }
 
 /**
- * @brief Benchmark a specific function
+ * @brief Verify the case folding and .gz/.br handling of Version 9
+ */
+bool verifyExtendedResolution()
+{
+  static const struct
+  {
+    const char *path;
+    const char *mime;
+    ContentEncoding encoding;
+  } cases[] = {
+      {"/IMAGE.PNG", T_image_png, ENCODING_IDENTITY},
+      {"/Index.Html", T_text_html, ENCODING_IDENTITY},
+      {"/fonts/Roboto.WOFF2", T_font_woff2, ENCODING_IDENTITY},
+      {"/app.js.gz", T_application_javascript, ENCODING_GZIP},
+      {"/style.CSS.GZ", T_text_css, ENCODING_GZIP},
+      {"/data.json.br", T_application_json, ENCODING_BROTLI},
+      {"/backup.tar.gz", T_application_octet_stream, ENCODING_IDENTITY},
+      {"/archive.gz", T_application_octet_stream, ENCODING_IDENTITY},
+      {"/dir.js/file.gz", T_application_octet_stream, ENCODING_IDENTITY},
+      {"/UNKNOWN.XYZ", T_application_octet_stream, ENCODING_IDENTITY},
+  };
+
+  Serial.println("=== VERIFYING CASE FOLDING AND PRE-COMPRESSED SUFFIXES (Version 9) ===");
+  bool ok = true;
+  for (const auto &test : cases)
+  {
+    _setContentTypeFromPath_v9(String(test.path));
+    bool match = strcmp(_contentType, test.mime) == 0 && _contentEncoding == test.encoding;
+    Serial.printf("%s: %s -> %s (encoding %d)\n", match ? "OK" : "MISMATCH", test.path, _contentType, _contentEncoding);
+    ok = ok && match;
+  }
+  Serial.println();
+  return ok;
+}
+
+/**
+ * @brief Check mimeIndicesFor() against mimeIndexFor() on every test path plus edge cases
+ * @note The edge cases cover the SWAR tail word: short paths, a '/' after the
+ *       dot, dots outside the last 8 bytes and a batch that is not a
+ *       multiple of MIME_BATCH_LANES.
+ */
+bool verifyBatchResolution()
+{
+  static const char *edgePaths[] = {
+      "", "a", ".", ".js", "/x.", "js", "/dir.js/file", "/a.woff2", "/b.c.woff2", "/file.longext",
+      "/archive.tar.gz", "/x/.htaccess", "/no_extension_at_all", "/v1.2/README",
+  };
+  static const int edgeCount = sizeof(edgePaths) / sizeof(edgePaths[0]);
+  static const int total = TEST_DATA_SIZE + DEEP_PATH_COUNT + edgeCount;
+  PathView views[total];
+  uint8_t indices[total];
+
+  Serial.println("=== VERIFYING BATCHED RESOLUTION ===");
+  for (int i = 0; i < total; i++)
+  {
+    const char *path = i < TEST_DATA_SIZE ? testPaths[i]
+                       : i < TEST_DATA_SIZE + DEEP_PATH_COUNT ? deepPaths[i - TEST_DATA_SIZE]
+                                                              : edgePaths[i - TEST_DATA_SIZE - DEEP_PATH_COUNT];
+    views[i] = {path, strlen(path)};
+  }
+  mimeIndicesFor(views, total, indices);
+
+  int mismatches = 0;
+  for (int i = 0; i < total; i++)
+  {
+    uint8_t expected = mimeIndexFor(views[i].data, views[i].len);
+    if (indices[i] != expected)
+    {
+      Serial.printf("MISMATCH: %s -> %u, expected %u\n", views[i].data, indices[i], expected);
+      mismatches++;
+    }
+  }
+  Serial.printf("%d paths, %d mismatches\n\n", total, mismatches);
+  return mismatches == 0;
+}
+
+/**
+ * @brief Every version against the reference: exhaustive extension sweep plus random paths
+ * @note Stops at nothing: all mismatches are counted, the first DIFF_REPORT_LIMIT are printed
  */
-uint64_t benchmarkFunction(void (*func)(const String &), const char *functionName)
+bool verifyDifferential()
 {
-  uint64_t totalTime = 0;
+  static DifferentialStats stats;
+  memset(&stats, 0, sizeof(stats));
 
-  Serial.printf("Benchmarking %s...\n", functionName);
+  Serial.printf("=== DIFFERENTIAL CHECK (extensions up to %d characters + %d random paths) ===\n", DIFF_SWEEP_MAX_LEN,
+                DIFF_RANDOM_PATHS);
+  uint64_t startTime = getMicros();
+  runExhaustiveSweep(stats);
+  runRandomPaths(DIFF_RANDOM_PATHS, WORKLOAD_SEED, stats);
 
-  for (int round = 0; round < BENCHMARK_ROUNDS; round++)
+  for (int v = 0; v < resolverCount(); v++)
   {
-    uint64_t startTime = getMicros();
+    Serial.printf("%-12s %s: %u mismatches\n", resolverAt(v).name,
+                  resolverAt(v).flags & RESOLVER_EXTENDED_SEMANTICS ? "extended reference" : "reference",
+                  stats.perResolver[v]);
+  }
+  Serial.printf("%u paths checked in %0.1f s, %u mismatches\n\n", stats.paths,
+                (getMicros() - startTime) / 1000000.0, stats.mismatches);
+  return stats.mismatches == 0;
+}
+
+struct BenchmarkContext
+{
+  void (*func)(const String &);
+  BenchmarkMode mode;
+};
+
+/**
+ * @brief Structured records of a benchmark result: median, confidence interval and cycles per call
+ */
+static void recordResult(const char *suite, const char *path, const BenchResult &result)
+{
+  benchRecord(suite, result.name, path, "median", result.median, "us", BENCHMARK_ITERATIONS);
+  benchRecord(suite, result.name, path, "ci_low", result.ciLow, "us", BENCHMARK_ITERATIONS);
+  benchRecord(suite, result.name, path, "ci_high", result.ciHigh, "us", BENCHMARK_ITERATIONS);
+  benchRecord(suite, result.name, path, "cycles_per_call", result.median * getCpuFrequencyMhz(), "cycles",
+              BENCHMARK_ITERATIONS);
+}
+
+/**
+ * @brief One round of benchmarkFunction(), returns μs per call
+ */
+static double benchmarkRound(void *context)
+{
+  const BenchmarkContext *bench = (const BenchmarkContext *)context;
+  void (*func)(const String &) = bench->func;
+  uint64_t startTime = getMicros();
 
-    // Perform benchmark iterations
+  // Perform benchmark iterations
+  if (bench->mode == BENCH_LOOKUP_ONLY)
+  {
     for (int iter = 0; iter < BENCHMARK_ITERATIONS; iter++)
     {
       // Use different test data to prevent compiler optimizations
+      func(testStrings[iter % TEST_DATA_SIZE]);
+
+      // Prevent compiler from optimizing away the function call
+      asm volatile("" ::"m"(_contentType) : "memory");
+    }
+  }
+  else
+  {
+    for (int iter = 0; iter < BENCHMARK_ITERATIONS; iter++)
+    {
       String testPath = String(testPaths[iter % TEST_DATA_SIZE]);
 
       func(testPath);
 
-      // Prevent compiler from optimizing away the function call
       asm volatile("" ::"m"(_contentType) : "memory");
     }
+  }
 
-    uint64_t endTime = getMicros();
-    uint64_t roundTime = endTime - startTime;
-    totalTime += roundTime;
+  return (double)(getMicros() - startTime) / BENCHMARK_ITERATIONS;
+}
 
-    Serial.printf("  Round %d: %llu μs (%0.5f μs per call)\n",
-                  round + 1, roundTime, (double)roundTime / BENCHMARK_ITERATIONS);
-  }
+/**
+ * @brief Benchmark a specific function
+ */
+void benchmarkFunction(void (*func)(const String &), const char *functionName, BenchmarkMode mode, BenchResult &result)
+{
+  BenchmarkContext context = {func, mode};
 
-  uint64_t avgTime = totalTime / BENCHMARK_ROUNDS;
-  double avgPerCall = (double)avgTime / BENCHMARK_ITERATIONS;
+  Serial.printf("Benchmarking %s (%s)...\n", functionName,
+                mode == BENCH_LOOKUP_ONLY ? "lookup only" : "end-to-end incl. allocation");
 
-  Serial.printf("  Average: %llu μs (%0.5f μs per call)\n\n", avgTime, avgPerCall);
+  benchRun(functionName, benchmarkRound, &context, benchConfig, result);
 
-  return avgTime;
+  Serial.printf("  Median: %0.5f μs per call (MAD %0.5f, %d%% CI [%0.5f, %0.5f], %d outlier rounds rejected)\n\n",
+                result.median, result.mad, (int)(BENCHMARK_CONFIDENCE * 100), result.ciLow, result.ciHigh,
+                result.outliers);
+  recordResult(mode == BENCH_LOOKUP_ONLY ? "lookup" : "end_to_end", "*", result);
 }
 
 /**
- * @brief Calculate performance improvement percentage
+ * @brief Checked guarantee: candidate costs at most limit times reference, from interleaved rounds
+ * @note Fails when the whole confidence interval of the ratio is above limit,
+ *       so noise around an equal cost does not fail the run.
  */
-void calculateImprovement(uint64_t time1, uint64_t time2, uint64_t time3)
+static bool requireCostRatio(const char *check, BenchRoundFn candidate, void *candidateContext, BenchRoundFn reference,
+                             void *referenceContext, double limit)
 {
-  Serial.println("=== PERFORMANCE COMPARISON ===");
-  Serial.printf("Version 1: %0.4f μs per call\n", (double)time1 / BENCHMARK_ITERATIONS);
-  Serial.printf("Version 2: %0.4f μs per call\n", (double)time2 / BENCHMARK_ITERATIONS);
-  Serial.printf("Version 3: %0.4f μs per call\n", (double)time3 / BENCHMARK_ITERATIONS);
+  BenchResult ratio;
+  benchPaired(check, candidate, candidateContext, reference, referenceContext, benchConfig, ratio);
+  Serial.printf("%s: cost ratio %0.3f (%d%% CI [%0.3f, %0.3f]), limit %0.3f\n", check, ratio.median,
+                (int)(BENCHMARK_CONFIDENCE * 100), ratio.ciLow, ratio.ciHigh, limit);
+  benchRecord("check", "", check, "cost_ratio", ratio.median, "ratio", BENCHMARK_ITERATIONS);
+  return benchRequire(ratio.ciLow <= limit, check);
+}
+
+/**
+ * @brief Case folding must not cost the lower case path: Version 9 no slower than Version 3 on testPaths
+ * @note "No slower" allows 3%: heap and code placement alone move equal-cost
+ *       code that much from one host run to the next, beyond the paired CI.
+ */
+static void requireNoSlowerLowerCase()
+{
+  BenchmarkContext candidate = {_setContentTypeFromPath_v9, BENCH_LOOKUP_ONLY};
+  BenchmarkContext reference = {_setContentTypeFromPath_v3, BENCH_LOOKUP_ONLY};
+  requireCostRatio("Version 9 no slower than Version 3 on lower case paths", benchmarkRound, &candidate,
+                   benchmarkRound, &reference, 1.03);
+  Serial.println();
+}
 
-  double improvement2 = ((double)(time1 - time2) / time1) * 100.0;
-  double improvement3 = ((double)(time1 - time3) / time1) * 100.0;
-  double speedup2 = (double)time1 / time2;
-  double speedup3 = (double)time1 / time3;
+/**
+ * @brief Print one min/p50/p90/p99/max row of a latency histogram, and its p50/p99 records
+ */
+static void printLatencyRow(const char *functionName, const char *label, const char *path,
+                            const LatencyHistogram &histogram)
+{
+  Serial.printf("  %-30s %8u %8u %8u %8u %8u\n", label, histogram.minValue(), histogram.percentile(0.50),
+                histogram.percentile(0.90), histogram.percentile(0.99), histogram.maxValue());
+  benchRecord("latency", functionName, path, "p50", histogram.percentile(0.50), "cycles", histogram.count());
+  benchRecord("latency", functionName, path, "p99", histogram.percentile(0.99), "cycles", histogram.count());
+}
 
-  Serial.printf("\nVersion 2 vs Version 1: %0.2f%% improvement, %0.2fx speedup\n",
-                improvement2, speedup2);
-  Serial.printf("Version 3 vs Version 1: %0.2f%% improvement, %0.2fx speedup\n",
-                improvement3, speedup3);
+/**
+ * @brief Per-call latency distribution of a function, per test path and overall
+ * @note Each call is timed with the cycle counter, minus the counter read overhead
+ */
+void benchmarkLatency(void (*func)(const String &), const char *functionName)
+{
+  static LatencyHistogram overall;
+  static LatencyHistogram perPath[TEST_DATA_SIZE];
 
-  // Find the fastest
-  uint64_t fastest = min(time1, min(time2, time3));
-  if (fastest == time1)
+  overall.reset();
+  for (int i = 0; i < TEST_DATA_SIZE; i++)
   {
-    Serial.println("✓ Version 1 is FASTEST");
+    perPath[i].reset();
   }
-  else if (fastest == time2)
+  uint32_t overhead = readCyclesOverhead();
+
+  for (int iter = 0; iter < BENCHMARK_ITERATIONS; iter++)
   {
-    Serial.println("✓ Version 2 is FASTEST");
+    int index = iter % TEST_DATA_SIZE;
+    uint32_t start = readCycles();
+
+    func(testStrings[index]);
+    asm volatile("" ::"m"(_contentType) : "memory");
+
+    uint32_t cycles = readCycles() - start;
+    cycles = cycles > overhead ? cycles - overhead : 0;
+    overall.record(cycles);
+    perPath[index].record(cycles);
   }
-  else
+
+  uint32_t cyclesPerMicro = cyclesPerMicrosecond();
+  Serial.printf("%s latency (cycles, %u cycles/μs, timer overhead %u cycles):\n", functionName, cyclesPerMicro, overhead);
+  Serial.printf("  %-30s %8s %8s %8s %8s %8s\n", "path", "min", "p50", "p90", "p99", "max");
+  for (int i = 0; i < TEST_DATA_SIZE; i++)
   {
-    Serial.println("✓ Version 3 is FASTEST");
+    printLatencyRow(functionName, testPaths[i], testPaths[i], perPath[i]);
   }
-  Serial.println();
+  printLatencyRow(functionName, "ALL", "*", overall);
+  Serial.printf("  ALL in ns: p50 %0.1f, p99 %0.1f, max %0.1f\n\n",
+                overall.percentile(0.50) * 1000.0 / cyclesPerMicro,
+                overall.percentile(0.99) * 1000.0 / cyclesPerMicro,
+                overall.maxValue() * 1000.0 / cyclesPerMicro);
 }
 
 /**
- * @brief Memory usage test
+ * @brief Calculate performance improvement percentage
+ * @note results[0] is the baseline. The fastest version is only declared
+ *       when it is statistically distinguishable from every other one.
  */
-void testMemoryUsage()
+void calculateImprovement(const BenchResult results[], int count)
 {
-  Serial.println("=== MEMORY USAGE TEST ===");
-
-  UBaseType_t stackBefore = uxTaskGetStackHighWaterMark(NULL);
-
-  // Test all versions
-  String testPath = "test.html";
-  for (int i = 0; i < 1000; i++)
+  Serial.println("=== PERFORMANCE COMPARISON ===");
+  for (int i = 0; i < count; i++)
   {
-    _setContentTypeFromPath_v1(testPath);
-    _setContentTypeFromPath_v2(testPath);
-    _setContentTypeFromPath_v3(testPath);
+    Serial.printf("%s: %0.4f μs per call (%d%% CI [%0.4f, %0.4f])\n", results[i].name, results[i].median,
+                  (int)(BENCHMARK_CONFIDENCE * 100), results[i].ciLow, results[i].ciHigh);
   }
+  Serial.println();
 
-  UBaseType_t stackAfter = uxTaskGetStackHighWaterMark(NULL);
+  const BenchResult &baseline = results[0];
+  for (int i = 1; i < count; i++)
+  {
+    double improvement = (baseline.median - results[i].median) / baseline.median * 100.0;
+    double speedup = baseline.median / results[i].median;
+    bool same = benchIndistinguishable(baseline, results[i], benchConfig);
+    Serial.printf("%s vs %s: %0.2f%% improvement, %0.2fx speedup%s\n", results[i].name, baseline.name,
+                  improvement, speedup, same ? " (not significant)" : "");
+  }
 
-  Serial.printf("Stack usage change: %d bytes\n", (stackBefore - stackAfter) * 4);
-  Serial.printf("Free heap: %d bytes\n", ESP.getFreeHeap());
-  Serial.printf("Free PSRAM: %d bytes\n", ESP.getFreePsram());
+  // Find the fastest, and everything it cannot be told apart from
+  int fastest = benchFastest(results, count);
+  bool tie = false;
+  for (int i = 0; i < count; i++)
+  {
+    double low, high;
+    if (i == fastest || !benchIndistinguishable(results[i], results[fastest], benchConfig, &low, &high))
+      continue;
+    if (!tie)
+    {
+      Serial.printf("≈ %s is fastest, but statistically indistinguishable from:\n", results[fastest].name);
+      tie = true;
+    }
+    Serial.printf("    %s (difference %d%% CI [%0.4f, %0.4f] μs)\n", results[i].name,
+                  (int)(BENCHMARK_CONFIDENCE * 100), low, high);
+  }
+  if (!tie)
+  {
+    Serial.printf("✓ %s is FASTEST\n", results[fastest].name);
+  }
+  Serial.println();
+}
+
+/**
+ * @brief Speedup of every version (row) over every other version (column)
+ * @note Cells marked with '~' are not statistically significant
+ */
+void printComparisonMatrix(const BenchResult results[], int count)
+{
+  Serial.println("=== COMPARISON MATRIX (row speedup over column) ===");
+  Serial.printf("%-16s", "");
+  for (int col = 0; col < count; col++)
+  {
+    Serial.printf("     #%-3d", col + 1);
+  }
+  Serial.println();
+
+  for (int row = 0; row < count; row++)
+  {
+    Serial.printf("#%-2d %-12.12s", row + 1, results[row].name);
+    for (int col = 0; col < count; col++)
+    {
+      if (row == col)
+      {
+        Serial.printf(" %8s", "-");
+        continue;
+      }
+      bool same = benchIndistinguishable(results[row], results[col], benchConfig);
+      Serial.printf(" %6.2fx%c", results[col].median / results[row].median, same ? '~' : ' ');
+    }
+    Serial.println();
+  }
+  Serial.println();
+}
+
+struct WorkloadContext
+{
+  void (*func)(const String &);
+  const Workload *workload;
+};
+
+/**
+ * @brief One round replaying a workload, returns μs per call
+ */
+static double workloadRound(void *context)
+{
+  const WorkloadContext *bench = (const WorkloadContext *)context;
+  void (*func)(const String &) = bench->func;
+  const Workload &workload = *bench->workload;
+  int position = 0;
+  uint64_t startTime = getMicros();
+
+  for (int iter = 0; iter < BENCHMARK_ITERATIONS; iter++)
+  {
+    func(workload.paths[workload.sequence[position]]);
+    asm volatile("" ::"m"(_contentType) : "memory");
+
+    if (++position == workload.length)
+      position = 0;
+  }
+
+  return (double)(getMicros() - startTime) / BENCHMARK_ITERATIONS;
+}
+
+/**
+ * @brief Replay a workload through every registered version and compare them
+ */
+void benchmarkWorkload(const Workload &workload)
+{
+  static BenchResult results[RESOLVER_REGISTRY_MAX];
+  int count = resolverCount();
+
+  Serial.printf("--- Workload: %s (%d requests, %d distinct paths) ---\n", workload.name, workload.length,
+                workload.pathCount);
+  version7Cache().clear();
+  for (int v = 0; v < count; v++)
+  {
+    WorkloadContext context = {resolverAt(v).func, &workload};
+    benchRun(resolverAt(v).name, workloadRound, &context, benchConfig, results[v], false);
+    recordResult("workload", workload.name, results[v]);
+  }
+  calculateImprovement(results, count);
+
+  const PathCacheStats &cache = version7Cache().stats();
+  Serial.printf("Version 7 path cache hit rate: %0.1f%% (%u hits, %u misses)\n\n",
+                cache.hits + cache.misses ? cache.hits * 100.0 / (cache.hits + cache.misses) : 0.0, cache.hits,
+                cache.misses);
+}
+
+/**
+ * @brief Setter through a function pointer, as the registry calls it
+ */
+static double setterPointerRound(void *context)
+{
+  void (*func)(const String &) = (void (*)(const String &))context;
+  uint64_t startTime = getMicros();
+  for (int iter = 0; iter < BENCHMARK_ITERATIONS; iter++)
+  {
+    func(testStrings[iter % TEST_DATA_SIZE]);
+    asm volatile("" ::"m"(_contentType) : "memory");
+  }
+  return (double)(getMicros() - startTime) / BENCHMARK_ITERATIONS;
+}
+
+/**
+ * @brief Setter called directly, the compiler may inline it
+ */
+static double setterDirectRound(void *)
+{
+  uint64_t startTime = getMicros();
+  for (int iter = 0; iter < BENCHMARK_ITERATIONS; iter++)
+  {
+    _setContentTypeFromPath_v10(testStrings[iter % TEST_DATA_SIZE]);
+    asm volatile("" ::"m"(_contentType) : "memory");
+  }
+  return (double)(getMicros() - startTime) / BENCHMARK_ITERATIONS;
+}
+
+/**
+ * @brief contentTypeFor() on a String, result kept in a register
+ */
+static double returnValueStringRound(void *)
+{
+  uint64_t startTime = getMicros();
+  for (int iter = 0; iter < BENCHMARK_ITERATIONS; iter++)
+  {
+    const String &path = testStrings[iter % TEST_DATA_SIZE];
+    const char *mime = contentTypeFor(path.c_str(), path.length());
+    asm volatile("" ::"r"(mime));
+  }
+  return (double)(getMicros() - startTime) / BENCHMARK_ITERATIONS;
+}
+
+/**
+ * @brief contentTypeFor() on a plain (char*, length) pair
+ */
+static double returnValueRawRound(void *)
+{
+  uint64_t startTime = getMicros();
+  for (int iter = 0; iter < BENCHMARK_ITERATIONS; iter++)
+  {
+    int index = iter % TEST_DATA_SIZE;
+    const char *mime = contentTypeFor(testPaths[index], testPathLengths[index]);
+    asm volatile("" ::"r"(mime));
+  }
+  return (double)(getMicros() - startTime) / BENCHMARK_ITERATIONS;
+}
+
+/**
+ * @brief Global setter vs return-value API, same lookup underneath
+ */
+void benchmarkCallStyles()
+{
+  static BenchResult results[4];
+
+  Serial.println("=== CALL STYLE: SETTER vs RETURN VALUE ===");
+  benchRun("setter via pointer", setterPointerRound, (void *)(ResolverFn)_setContentTypeFromPath_v10, benchConfig, results[0], false);
+  benchRun("setter direct", setterDirectRound, nullptr, benchConfig, results[1], false);
+  benchRun("return (String)", returnValueStringRound, nullptr, benchConfig, results[2], false);
+  benchRun("return (char*, len)", returnValueRawRound, nullptr, benchConfig, results[3], false);
+  calculateImprovement(results, 4);
+}
+
+static PathView batchPaths[BATCH_SIZE];
+static uint8_t batchIndices[BATCH_SIZE];
+
+/**
+ * @brief A String built for each listed file, then Version 8
+ */
+static double batchStringRound(void *)
+{
+  int passes = BENCHMARK_ITERATIONS / BATCH_SIZE;
+  uint64_t startTime = getMicros();
+  for (int pass = 0; pass < passes; pass++)
+  {
+    for (int i = 0; i < BATCH_SIZE; i++)
+    {
+      _setContentTypeFromPath_v8(String(batchPaths[i].data, batchPaths[i].len));
+      asm volatile("" ::"m"(_contentType) : "memory");
+    }
+  }
+  return (double)(getMicros() - startTime) / (passes * BATCH_SIZE);
+}
+
+/**
+ * @brief mimeIndexFor() called once per listed file
+ */
+static double batchScalarRound(void *)
+{
+  int passes = BENCHMARK_ITERATIONS / BATCH_SIZE;
+  uint64_t startTime = getMicros();
+  for (int pass = 0; pass < passes; pass++)
+  {
+    for (int i = 0; i < BATCH_SIZE; i++)
+      batchIndices[i] = mimeIndexFor(batchPaths[i].data, batchPaths[i].len);
+    asm volatile("" ::"m"(batchIndices) : "memory");
+  }
+  return (double)(getMicros() - startTime) / (passes * BATCH_SIZE);
+}
+
+/**
+ * @brief One mimeIndicesFor() call per listing
+ */
+static double batchRound(void *)
+{
+  int passes = BENCHMARK_ITERATIONS / BATCH_SIZE;
+  uint64_t startTime = getMicros();
+  for (int pass = 0; pass < passes; pass++)
+  {
+    mimeIndicesFor(batchPaths, BATCH_SIZE, batchIndices);
+    asm volatile("" ::"m"(batchIndices) : "memory");
+  }
+  return (double)(getMicros() - startTime) / (passes * BATCH_SIZE);
+}
+
+/**
+ * @brief Paths per second of a BATCH_SIZE file listing: per-file String + setter, scalar loop and batch call
+ */
+void benchmarkBatch()
+{
+  static BenchResult results[3];
+
+  for (int i = 0; i < BATCH_SIZE; i++)
+  {
+    const char *path = (i % 5 == 4) ? deepPaths[(i / 5) % DEEP_PATH_COUNT] : testPaths[i % TEST_DATA_SIZE];
+    batchPaths[i] = {path, strlen(path)};
+  }
+
+  Serial.printf("=== BATCHED RESOLUTION (%d paths per listing) ===\n", BATCH_SIZE);
+  benchRun("String + Version 8", batchStringRound, nullptr, benchConfig, results[0], false);
+  benchRun("mimeIndexFor loop", batchScalarRound, nullptr, benchConfig, results[1], false);
+  benchRun("mimeIndicesFor batch", batchRound, nullptr, benchConfig, results[2], false);
+  for (const BenchResult &result : results)
+  {
+    Serial.printf("%-24s %8.2f Mpaths/s\n", result.name, result.median > 0 ? 1.0 / result.median : 0.0);
+  }
+  calculateImprovement(results, 3);
+}
+
+#if RESOLVER_TELEMETRY
+#define TELEMETRY_OVERHEAD_LIMIT 1.01 // Cost ratio the counters may add to a request: 1%
+
+struct TelemetryRoundContext
+{
+  bool counted; // resolveContentType() on counters fetched once, else contentTypeFor()
+  bool request; // String copy of the path first, as request->url() does
+};
+
+/**
+ * @brief Embedded access trace through one TelemetryRoundContext, returns μs per call
+ */
+static double telemetryRound(void *context)
+{
+  const TelemetryRoundContext &round = *(const TelemetryRoundContext *)context;
+  TelemetryCounters &counters = telemetryLocalCounters();
+  int passes = BENCHMARK_ITERATIONS / ACCESS_TRACE_LENGTH;
+  uint64_t startTime = getMicros();
+  for (int pass = 0; pass < passes; pass++)
+  {
+    for (int i = 0; i < ACCESS_TRACE_LENGTH; i++)
+    {
+      uint8_t index = accessTraceSequence[i];
+      const char *mime;
+      if (round.request)
+      {
+        String url(accessTracePaths[index], accessTraceLengths[index]);
+        mime = round.counted ? resolveContentType(counters, url.c_str(), url.length())
+                             : contentTypeFor(url.c_str(), url.length());
+      }
+      else
+      {
+        mime = round.counted ? resolveContentType(counters, accessTracePaths[index], accessTraceLengths[index])
+                             : contentTypeFor(accessTracePaths[index], accessTraceLengths[index]);
+      }
+      asm volatile("" ::"r"(mime) : "memory");
+    }
+  }
+  return (double)(getMicros() - startTime) / (passes * ACCESS_TRACE_LENGTH);
+}
+
+/**
+ * @brief Cost of the always-on counters, checked against a request, then one report of a single trace replay
+ */
+void benchmarkTelemetry()
+{
+  static const TelemetryRoundContext bareLookup = {false, false};
+  static const TelemetryRoundContext countedLookup = {true, false};
+  static const TelemetryRoundContext bareRequest = {false, true};
+  static const TelemetryRoundContext countedRequest = {true, true};
+  BenchResult ratio;
+
+  Serial.printf("=== RESOLVER TELEMETRY (1 lookup in %d per type timed) ===\n", TELEMETRY_SAMPLE_INTERVAL);
+  benchPaired("resolveContentType / contentTypeFor", telemetryRound, (void *)&countedLookup, telemetryRound,
+              (void *)&bareLookup, benchConfig, ratio);
+  Serial.printf("Counters against the bare lookup: cost ratio %0.3f (%d%% CI [%0.3f, %0.3f])\n", ratio.median,
+                (int)(BENCHMARK_CONFIDENCE * 100), ratio.ciLow, ratio.ciHigh);
+  benchRecord("telemetry", "resolveContentType", "*", "lookup_ratio", ratio.median, "ratio", BENCHMARK_ITERATIONS);
+  requireCostRatio("Telemetry within 1% of the request path", telemetryRound, (void *)&countedRequest,
+                   telemetryRound, (void *)&bareRequest, TELEMETRY_OVERHEAD_LIMIT);
+
+  TelemetryReport report;
+  telemetryCollect(report); // Drop the benchmark calls
+  TelemetryCounters &counters = telemetryLocalCounters();
+  for (int i = 0; i < ACCESS_TRACE_LENGTH; i++)
+  {
+    uint8_t index = accessTraceSequence[i];
+    resolveContentType(counters, accessTracePaths[index], accessTraceLengths[index]);
+  }
+  telemetryCollect(report);
+  printTelemetryReport(report);
+  Serial.println();
+}
+#else
+void benchmarkTelemetry()
+{
+  Serial.println("=== RESOLVER TELEMETRY ===");
+  Serial.println("Built with RESOLVER_TELEMETRY=0, nothing to measure\n");
+}
+#endif
+
+// ========================================
+// SIMULATED REQUEST LOOP
+// ========================================
+//
+// Each trace path is written into one buffer as a raw request head
+// ("GET /css/style.css?v=5 HTTP/1.1 ..."). A handler either builds a
+// String from the URL slice, as request->url() does, or resolves the
+// slice in place. The slice is followed by '?', never by a NUL.
+
+static char requestBuffer[REQUEST_BUFFER_SIZE];
+static PathView requestUrls[ACCESS_TRACE_PATHS]; // Slices of requestBuffer
+
+struct RequestCandidate
+{
+  const char *name;
+  ResolverFn fromString;
+  void (*fromView)(const char *path, size_t len);
+};
+
+static const RequestCandidate requestCandidates[] = {
+    {"Version 8", _setContentTypeFromPath_v8, _setContentTypeFromPath_v8},
+    {"Version 10", _setContentTypeFromPath_v10, _setContentTypeFromPath_v10},
+    {"Version 11", _setContentTypeFromPath_v11, _setContentTypeFromPath_v11},
+};
+
+#define REQUEST_CANDIDATE_COUNT (sizeof(requestCandidates) / sizeof(requestCandidates[0]))
+
+struct RequestRoundContext
+{
+  const RequestCandidate *candidate;
+  bool view;
+};
+
+/**
+ * @brief Serve one trace request: String copy of the URL slice, or the slice itself
+ */
+static inline void serveRequest(const RequestRoundContext &context, const PathView &url)
+{
+  if (context.view)
+    context.candidate->fromView(url.data, url.len);
+  else
+    context.candidate->fromString(String(url.data, url.len));
+  asm volatile("" ::"m"(_contentType) : "memory");
+}
+
+/**
+ * @brief One pass set over the embedded trace, returns μs per request
+ */
+static double requestLoopRound(void *context)
+{
+  const RequestRoundContext &request = *(const RequestRoundContext *)context;
+  int passes = BENCHMARK_ITERATIONS / ACCESS_TRACE_LENGTH;
+  uint64_t startTime = getMicros();
+  for (int pass = 0; pass < passes; pass++)
+  {
+    for (int i = 0; i < ACCESS_TRACE_LENGTH; i++)
+      serveRequest(request, requestUrls[accessTraceSequence[i]]);
+  }
+  return (double)(getMicros() - startTime) / (passes * ACCESS_TRACE_LENGTH);
+}
+
+/**
+ * @brief Write the request heads into requestBuffer and slice out their URLs
+ * @return false when requestBuffer is too small (REQUEST_HEAD_BYTES no longer covers the head)
+ */
+static bool buildRequestBuffer()
+{
+  size_t used = 0;
+  for (int i = 0; i < ACCESS_TRACE_PATHS; i++)
+  {
+    int written = snprintf(requestBuffer + used, REQUEST_BUFFER_SIZE - used,
+                           "GET %s?v=%d HTTP/1.1\r\nHost: esp32.local\r\nAccept: */*\r\n\r\n", accessTracePaths[i], i);
+    if (written < 0 || used + (size_t)written >= REQUEST_BUFFER_SIZE)
+      return false;
+    requestUrls[i] = {requestBuffer + used + 4, accessTraceLengths[i]};
+    used += (size_t)written;
+  }
+  return true;
+}
+
+/**
+ * @brief Heap churn and latency of String-based vs view-based resolution in a simulated request loop
+ * @return false when a view overload disagrees with contentTypeFor()
+ */
+bool benchmarkRequestLoop()
+{
+  static BenchResult results[REQUEST_CANDIDATE_COUNT][2];
+  static LatencyHistogram latency;
+
+  Serial.println("=== REQUEST LOOP: String vs VIEW ===");
+  if (!buildRequestBuffer())
+  {
+    Serial.printf("❌ Request heads do not fit in the %u byte buffer\n\n", (unsigned)REQUEST_BUFFER_SIZE);
+    return false;
+  }
+  for (const RequestCandidate &candidate : requestCandidates)
+  {
+    for (const PathView &url : requestUrls)
+    {
+      candidate.fromView(url.data, url.len);
+      if (strcmp(_contentType, contentTypeFor(url.data, url.len)) != 0)
+      {
+        Serial.printf("❌ %s: wrong type for the slice %.*s\n", candidate.name, (int)url.len, url.data);
+        return false;
+      }
+    }
+  }
+
+  bool hook = heapHookActive();
+  uint32_t overhead = readCyclesOverhead();
+  uint32_t cyclesPerMicro = cyclesPerMicrosecond();
+  Serial.printf("%d requests from the embedded trace, URL slices of one %u byte buffer\n", ACCESS_TRACE_LENGTH,
+                (unsigned)sizeof(requestBuffer));
+  Serial.printf("  %-12s %-7s %10s %12s %10s %10s\n", "version", "input", "μs/req", "allocs/req", "p50 ns", "p99 ns");
+  for (size_t c = 0; c < REQUEST_CANDIDATE_COUNT; c++)
+  {
+    for (int view = 0; view < 2; view++)
+    {
+      RequestRoundContext context = {&requestCandidates[c], view != 0};
+      BenchResult &result = results[c][view];
+      benchRun(requestCandidates[c].name, requestLoopRound, &context, benchConfig, result, false);
+
+      uint32_t before = heapAllocationCount();
+      latency.reset();
+      for (int i = 0; i < ACCESS_TRACE_LENGTH; i++)
+      {
+        uint32_t start = readCycles();
+        serveRequest(context, requestUrls[accessTraceSequence[i]]);
+        uint32_t cycles = readCycles() - start;
+        latency.record(cycles > overhead ? cycles - overhead : 0);
+      }
+      double allocs = (double)(heapAllocationCount() - before) / ACCESS_TRACE_LENGTH;
+
+      const char *input = view ? "view" : "String";
+      if (hook)
+        Serial.printf("  %-12s %-7s %10.4f %12.2f %10.1f %10.1f\n", result.name, input, result.median, allocs,
+                      latency.percentile(0.50) * 1000.0 / cyclesPerMicro,
+                      latency.percentile(0.99) * 1000.0 / cyclesPerMicro);
+      else
+        Serial.printf("  %-12s %-7s %10.4f %12s %10.1f %10.1f\n", result.name, input, result.median, "-",
+                      latency.percentile(0.50) * 1000.0 / cyclesPerMicro,
+                      latency.percentile(0.99) * 1000.0 / cyclesPerMicro);
+
+      recordResult(view ? "request_view" : "request_string", "*", result);
+      benchRecord(view ? "request_view" : "request_string", result.name, "*", "p99", latency.percentile(0.99),
+                  "cycles", latency.count());
+      if (hook)
+        benchRecord(view ? "request_view" : "request_string", result.name, "*", "allocs_per_request", allocs,
+                    "allocs", ACCESS_TRACE_LENGTH);
+    }
+  }
+  for (size_t c = 0; c < REQUEST_CANDIDATE_COUNT; c++)
+  {
+    double saved = results[c][0].median - results[c][1].median;
+    Serial.printf("%s: the view saves %0.1f ns per request (%0.2fx)\n", requestCandidates[c].name, saved * 1000.0,
+                  results[c][1].median > 0 ? results[c][0].median / results[c][1].median : 0.0);
+  }
+  Serial.println();
+  return true;
+}
+
+struct RegistryRoundContext
+{
+  const MimeRegistry *registry; // nullptr = contentTypeFor(), the built-in table alone
+  const char *const *paths;
+  const size_t *lengths;
+};
+
+/**
+ * @brief MimeRegistry::lookup() over REGISTRY_PROBE_PATHS paths, returns μs per call
+ */
+static double registryRound(void *context)
+{
+  const RegistryRoundContext &ctx = *(const RegistryRoundContext *)context;
+  uint64_t startTime = getMicros();
+  for (int iter = 0; iter < BENCHMARK_ITERATIONS; iter++)
+  {
+    int index = iter % REGISTRY_PROBE_PATHS;
+    const char *mime = ctx.registry ? ctx.registry->lookup(ctx.paths[index], ctx.lengths[index])
+                                    : contentTypeFor(ctx.paths[index], ctx.lengths[index]);
+    asm volatile("" ::"r"(mime));
+  }
+  return (double)(getMicros() - startTime) / BENCHMARK_ITERATIONS;
+}
+
+/**
+ * @brief Lookup cost of built-in, added and unknown extensions as the registry grows to 500 entries
+ * @note Added extensions are synthetic (".x000", ".x001", ...). Built-in
+ *       lookups are compared against contentTypeFor(): they must not slow down.
+ */
+void benchmarkRegistryGrowth()
+{
+  static const int sizes[] = {(int)MIME_TABLE_SIZE, 50, 100, 250, 500};
+  static MimeRegistry growing;
+  static char overflowPaths[REGISTRY_PROBE_PATHS][24];
+  static char missPaths[REGISTRY_PROBE_PATHS][24];
+  static const char *overflowPtrs[REGISTRY_PROBE_PATHS];
+  static const char *missPtrs[REGISTRY_PROBE_PATHS];
+  static size_t overflowLengths[REGISTRY_PROBE_PATHS];
+  static size_t missLengths[REGISTRY_PROBE_PATHS];
+  BenchResult result;
+  char ext[16];
+
+  Serial.println("=== RUNTIME MIME REGISTRY ===");
+  MimeRegistry &registry = mimeRegistry();
+  Serial.printf("%u extra types loaded, %u entries, %u heap bytes\n", (unsigned)registry.overflowSize(),
+                (unsigned)registry.size(), (unsigned)registry.footprint());
+
+  for (int i = 0; i < REGISTRY_PROBE_PATHS; i++)
+  {
+    snprintf(missPaths[i], sizeof(missPaths[i]), "/data/file.q%02d", i);
+    missPtrs[i] = missPaths[i];
+    missLengths[i] = strlen(missPaths[i]);
+  }
+
+  RegistryRoundContext builtIn = {nullptr, testPaths, testPathLengths};
+  benchRun("contentTypeFor", registryRound, &builtIn, benchConfig, result, false);
+  Serial.printf("contentTypeFor, built-in table only: %0.1f ns per call\n", result.median * 1000.0);
+  Serial.printf("  %8s %12s %12s %12s %10s\n", "entries", "built-in ns", "added ns", "unknown ns", "heap B");
+
+  growing.clear();
+  for (int sizeIndex = 0; sizeIndex < (int)(sizeof(sizes) / sizeof(sizes[0])); sizeIndex++)
+  {
+    int added = sizes[sizeIndex] - (int)MIME_TABLE_SIZE;
+    for (int i = (int)growing.overflowSize(); i < added; i++)
+    {
+      snprintf(ext, sizeof(ext), "x%03d", i);
+      growing.add(ext, "application/x-synthetic");
+    }
+    for (int i = 0; added > 0 && i < REGISTRY_PROBE_PATHS; i++)
+    {
+      snprintf(overflowPaths[i], sizeof(overflowPaths[i]), "/data/file.x%03d", i * added / REGISTRY_PROBE_PATHS);
+      overflowPtrs[i] = overflowPaths[i];
+      overflowLengths[i] = strlen(overflowPaths[i]);
+    }
+
+    RegistryRoundContext hits = {&growing, testPaths, testPathLengths};
+    RegistryRoundContext extra = {&growing, overflowPtrs, overflowLengths};
+    RegistryRoundContext misses = {&growing, missPtrs, missLengths};
+    benchRun("built-in", registryRound, &hits, benchConfig, result, false);
+    double builtInNs = result.median * 1000.0;
+    double addedNs = 0;
+    if (added > 0)
+    {
+      benchRun("added", registryRound, &extra, benchConfig, result, false);
+      addedNs = result.median * 1000.0;
+    }
+    benchRun("unknown", registryRound, &misses, benchConfig, result, false);
+    double unknownNs = result.median * 1000.0;
+
+    char addedColumn[16] = "-";
+    if (added > 0)
+      snprintf(addedColumn, sizeof(addedColumn), "%0.1f", addedNs);
+    Serial.printf("  %8u %12.1f %12s %12.1f %10u\n", (unsigned)growing.size(), builtInNs, addedColumn, unknownNs,
+                  (unsigned)growing.footprint());
+  }
+  growing.clear();
+  Serial.println();
+}
+
+/**
+ * @brief Version 11 lookup as a return-value resolver, for the parallel benchmark
+ */
+static const char *dfaContentTypeFor(const char *path, size_t len)
+{
+  const char *dot = findExtension(path, len);
+  return mimeTypeOf(dot ? mimeDfaIndex(dot + 1, (size_t)(path + len - dot - 1)) : (uint8_t)MIME_INDEX_NONE);
+}
+
+/**
+ * @brief Throughput of one resolver on 1 and on all workers, and the scaling efficiency
+ */
+static void reportParallel(ParallelResolverFn func, const char *name, int workers, bool sharedSink)
+{
+  ParallelResult single;
+  ParallelResult all;
+  if (!benchmarkParallel(func, testStrings, TEST_DATA_SIZE, BENCHMARK_ITERATIONS, 1, sharedSink, single) ||
+      !benchmarkParallel(func, testStrings, TEST_DATA_SIZE, BENCHMARK_ITERATIONS, workers, sharedSink, all))
+  {
+    Serial.printf("%-34s ❌ could not start the worker tasks\n", name);
+    return;
+  }
+
+  Serial.printf("%-34s 1 worker: %7.2f Mcalls/s, %d workers: %7.2f Mcalls/s (", name, single.callsPerSecond / 1e6,
+                all.workers, all.callsPerSecond / 1e6);
+  for (int i = 0; i < all.workers; i++)
+  {
+    Serial.printf(i ? " / %0.2f" : "%0.2f", all.workerCallsPerSecond[i] / 1e6);
+  }
+  Serial.printf("), scaling efficiency %0.1f%%\n",
+                single.callsPerSecond > 0 ? all.callsPerSecond / (single.callsPerSecond * all.workers) * 100.0 : 0.0);
+}
+
+/**
+ * @brief Return-value resolvers on all cores at once, each worker with its own result sink or all sharing one
+ * @note The registered setters all store into the plain global _contentType,
+ *       which is a data race on several threads: they are not run here. The
+ *       shared sink rows show what that one global costs.
+ */
+void benchmarkParallelThroughput()
+{
+  int workers = parallelMaxWorkers();
+
+  Serial.printf("=== PARALLEL THROUGHPUT (%d workers) ===\n", workers);
+  reportParallel(contentTypeFor, "perfect hash, own sink", workers, false);
+  reportParallel(contentTypeFor, "perfect hash, shared sink", workers, true);
+  reportParallel(dfaContentTypeFor, "DFA (Version 11), own sink", workers, false);
+  reportParallel(dfaContentTypeFor, "DFA (Version 11), shared sink", workers, true);
+  Serial.println();
+}
+
+/**
+ * @brief Lookup and end-to-end benchmarks of every version at each CPU clock of SWEEP_FREQUENCIES_MHZ
+ * @note Flash wait states do not scale with the CPU clock, so table heavy
+ *       and branch heavy versions can swap places at lower clocks. The
+ *       original clock is restored at the end.
+ */
+void benchmarkFrequencySweep()
+{
+  static const uint32_t steps[] = SWEEP_FREQUENCIES_MHZ;
+  static const int stepCount = sizeof(steps) / sizeof(steps[0]);
+  static_assert(stepCount <= SWEEP_MAX_STEPS, "Too many sweep frequencies");
+  static BenchResult lookup[SWEEP_MAX_STEPS][RESOLVER_REGISTRY_MAX];
+  static BenchResult endToEnd[SWEEP_MAX_STEPS][RESOLVER_REGISTRY_MAX];
+  uint32_t measuredMhz[SWEEP_MAX_STEPS] = {}; // 0 = step skipped
+  int measuredSteps = 0;
+  uint32_t original = getCpuFrequencyMhz();
+  int count = resolverCount();
+
+  Serial.println("=== CPU FREQUENCY SWEEP ===");
+  for (int s = 0; s < stepCount; s++)
+  {
+    if (!setCpuFrequencyMhz(steps[s]))
+    {
+      Serial.printf("%u MHz: not available, skipped\n", steps[s]);
+      continue;
+    }
+    delay(100); // Let the serial port settle at the new clock
+    measuredMhz[s] = getCpuFrequencyMhz();
+    Serial.printf("--- %u MHz ---\n", measuredMhz[s]);
+    for (int v = 0; v < count; v++)
+    {
+      BenchmarkContext lookupContext = {resolverAt(v).func, BENCH_LOOKUP_ONLY};
+      BenchmarkContext endToEndContext = {resolverAt(v).func, BENCH_END_TO_END};
+      benchRun(resolverAt(v).name, benchmarkRound, &lookupContext, benchConfig, lookup[s][v], false);
+      benchRun(resolverAt(v).name, benchmarkRound, &endToEndContext, benchConfig, endToEnd[s][v], false);
+      recordResult("sweep_lookup", "*", lookup[s][v]);
+      recordResult("sweep_end_to_end", "*", endToEnd[s][v]);
+    }
+    calculateImprovement(lookup[s], count);
+    measuredSteps++;
+  }
+  setCpuFrequencyMhz(original);
+  delay(100);
+  if (!measuredSteps)
+  {
+    Serial.println();
+    return;
+  }
+
+  Serial.printf("Lookup cost per call (ns / cycles), back at %u MHz:\n", getCpuFrequencyMhz());
+  Serial.printf("  %-12s", "version");
+  for (int s = 0; s < stepCount; s++)
+  {
+    if (measuredMhz[s])
+      Serial.printf("     %4u MHz ns / cyc", measuredMhz[s]);
+  }
+  Serial.println();
+  for (int v = 0; v < count; v++)
+  {
+    Serial.printf("  %-12s", resolverAt(v).name);
+    for (int s = 0; s < stepCount; s++)
+    {
+      if (measuredMhz[s])
+        Serial.printf("  %9.1f / %7.1f", lookup[s][v].median * 1000.0, lookup[s][v].median * measuredMhz[s]);
+    }
+    Serial.println();
+  }
+  Serial.println();
+}
+
+/**
+ * @brief Show how much of the end-to-end cost is String construction
+ */
+void reportAllocationCost(const BenchResult lookupResults[], const BenchResult endToEndResults[], int count)
+{
+  Serial.println("=== LOOKUP vs END-TO-END (incl. String allocation) ===");
+  for (int i = 0; i < count; i++)
+  {
+    double lookup = lookupResults[i].median;
+    double endToEnd = endToEndResults[i].median;
+    Serial.printf("%s: lookup %0.4f μs, end-to-end %0.4f μs, allocation share %0.1f%%\n",
+                  lookupResults[i].name, lookup, endToEnd, endToEnd > 0 ? (endToEnd - lookup) / endToEnd * 100.0 : 0.0);
+  }
+  Serial.println();
+}
+
+/**
+ * @brief Stack depth and heap allocations per call of every version
+ * @note Stack is measured in an isolated task, so the versions do not mask each other
+ */
+void testMemoryUsage()
+{
+  Serial.println("=== MEMORY USAGE TEST ===");
+
+  static size_t stack[RESOLVER_REGISTRY_MAX];
+  static double lookupAllocs[RESOLVER_REGISTRY_MAX];
+  static double endToEndAllocs[RESOLVER_REGISTRY_MAX];
+  int count = resolverCount();
+  bool hook = heapHookActive();
+
+  for (int v = 0; v < count; v++)
+  {
+    ResolverFn func = resolverAt(v).func;
+    stack[v] = measureStackDepth(func, testStrings, TEST_DATA_SIZE);
+
+    uint32_t before = heapAllocationCount();
+    for (int i = 0; i < MEMORY_TEST_CALLS; i++)
+    {
+      func(testStrings[i % TEST_DATA_SIZE]);
+    }
+    lookupAllocs[v] = (double)(heapAllocationCount() - before) / MEMORY_TEST_CALLS;
+
+    before = heapAllocationCount();
+    for (int i = 0; i < MEMORY_TEST_CALLS; i++)
+    {
+      func(String(testPaths[i % TEST_DATA_SIZE]));
+    }
+    endToEndAllocs[v] = (double)(heapAllocationCount() - before) / MEMORY_TEST_CALLS;
+  }
+
+  Serial.printf("  %-12s %12s %14s %14s\n", "version", "stack bytes", "allocs/lookup", "allocs/e2e");
+  for (int v = 0; v < count; v++)
+  {
+    char stackColumn[16] = "n/a"; // 0: the probe could not run
+    if (stack[v])
+      snprintf(stackColumn, sizeof(stackColumn), "%u", (unsigned)stack[v]);
+    if (hook)
+      Serial.printf("  %-12s %12s %14.2f %14.2f\n", resolverAt(v).name, stackColumn, lookupAllocs[v],
+                    endToEndAllocs[v]);
+    else
+      Serial.printf("  %-12s %12s %14s %14s\n", resolverAt(v).name, stackColumn, "-", "-");
+  }
+  if (!hook)
+  {
+    Serial.println("  (allocations not counted: link with -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc)");
+  }
+  for (int v = 0; v < count; v++)
+  {
+    if (stack[v])
+      benchRecord("footprint", resolverAt(v).name, "*", "stack_bytes", (double)stack[v], "bytes");
+    if (hook)
+    {
+      benchRecord("footprint", resolverAt(v).name, "*", "allocs_per_lookup", lookupAllocs[v], "allocs",
+                  MEMORY_TEST_CALLS);
+      benchRecord("footprint", resolverAt(v).name, "*", "allocs_per_end_to_end", endToEndAllocs[v], "allocs",
+                  MEMORY_TEST_CALLS);
+    }
+  }
+
+  Serial.printf("Version 7 path cache: %u bytes (%d slots)\n", (unsigned)PathCache::footprint(), PATH_CACHE_SLOTS);
+  Serial.printf("Version 11 DFA: %u bytes rodata (%u states x %u character classes)\n", (unsigned)sizeof(mimeDfa),
+                (unsigned)MIME_DFA_SHAPE.states, (unsigned)MIME_DFA_SHAPE.classes);
+  benchRecord("footprint", "Version 11", "*", "table_rodata_bytes", (double)sizeof(mimeDfa), "bytes");
+  Serial.printf("Free heap: %d bytes\n", ESP.getFreeHeap());
+  Serial.printf("Free PSRAM: %d bytes\n", ESP.getFreePsram());
+  Serial.println("Code, rodata and static RAM per version: python3 tools/resolver_footprint.py <firmware.elf>");
   Serial.println();
 }
 
@@ -524,7 +1850,7 @@ void setup()
   Serial.printf("CPU Frequency: %d MHz\n", getCpuFrequencyMhz());
   Serial.printf("Flash Speed: %d MHz\n", ESP.getFlashChipSpeed() / 1000000);
   Serial.printf("Benchmark iterations: %d\n", BENCHMARK_ITERATIONS);
-  Serial.printf("Benchmark rounds: %d\n", BENCHMARK_ROUNDS);
+  Serial.printf("Benchmark rounds: %d (+%d warmup)\n", BENCHMARK_ROUNDS, BENCHMARK_WARMUP_ROUNDS);
   Serial.println();
 
   // Step 1: Verify functions produce identical results
@@ -534,21 +1860,118 @@ void setup()
     return;
   }
 
+  if (!verifyExtendedResolution())
+  {
+    Serial.println("❌ VERSION 9 CASE/ENCODING HANDLING IS WRONG! Stopping benchmark.");
+    return;
+  }
+
+  if (!verifyDifferential())
+  {
+    Serial.println("❌ A VERSION DISAGREES WITH THE REFERENCE! Stopping benchmark.");
+    return;
+  }
+
+  if (!verifyBatchResolution())
+  {
+    Serial.println("❌ BATCHED RESOLUTION DOES NOT MATCH! Stopping benchmark.");
+    return;
+  }
+
+#if defined(BENCH_NATIVE)
+  const char *mimeTypesFile = getenv("BENCH_MIME_TYPES");
+#else
+  const char *mimeTypesFile = MIME_TYPES_FILE;
+#endif
+  if (mimeTypesFile && mimeRegistry().load(mimeTypesFile) < 0)
+  {
+    Serial.printf("No extra MIME types (%s not found)\n\n", mimeTypesFile);
+  }
+
   // Step 2: Memory usage test
+  prepareTestStrings();
   testMemoryUsage();
 
   // Step 3: Performance benchmark
   Serial.println("=== PERFORMANCE BENCHMARK ===");
   delay(3000);
 
-  uint64_t time1 = benchmarkFunction(_setContentTypeFromPath_v1, "Version 1");
-  uint64_t time2 = benchmarkFunction(_setContentTypeFromPath_v2, "Version 2");
-  uint64_t time3 = benchmarkFunction(_setContentTypeFromPath_v3, "Version 3");
+  static BenchResult lookupResults[RESOLVER_REGISTRY_MAX];
+  static BenchResult endToEndResults[RESOLVER_REGISTRY_MAX];
+  int count = resolverCount();
+  for (int v = 0; v < count; v++)
+  {
+    benchmarkFunction(resolverAt(v).func, resolverAt(v).name, BENCH_LOOKUP_ONLY, lookupResults[v]);
+  }
+  for (int v = 0; v < count; v++)
+  {
+    benchmarkFunction(resolverAt(v).func, resolverAt(v).name, BENCH_END_TO_END, endToEndResults[v]);
+  }
 
   // Step 4: Calculate and display results
-  calculateImprovement(time1, time2, time3);
+  calculateImprovement(lookupResults, count);
+  requireNoSlowerLowerCase();
+  printComparisonMatrix(lookupResults, count);
+  reportAllocationCost(lookupResults, endToEndResults, count);
+
+  benchmarkCallStyles();
+
+  benchmarkBatch();
 
-  // Step 5: Additional system info
+  benchmarkTelemetry();
+
+  if (!benchmarkRequestLoop())
+  {
+    Serial.println("❌ VIEW OVERLOADS DO NOT MATCH! Stopping benchmark.");
+    return;
+  }
+
+  benchmarkRegistryGrowth();
+
+  benchmarkFrequencySweep();
+
+  benchmarkParallelThroughput();
+
+  // Step 5: Per-call latency distribution
+  Serial.println("=== LATENCY DISTRIBUTION ===");
+  for (int v = 0; v < count; v++)
+  {
+    benchmarkLatency(resolverAt(v).func, resolverAt(v).name);
+  }
+  if (!runPlacementStudy(testStrings, TEST_DATA_SIZE))
+  {
+    Serial.println("❌ PLACEMENT VARIANTS DO NOT MATCH! Stopping benchmark.");
+    return;
+  }
+
+  // Step 6: Realistic and synthetic request mixes
+  Serial.println("=== WORKLOAD REPLAY ===");
+  static Workload workload;
+  buildSequentialWorkload(workload, testPaths, TEST_DATA_SIZE);
+  benchmarkWorkload(workload);
+  buildUniformWorkload(workload, testPaths, TEST_DATA_SIZE, WORKLOAD_SEED);
+  benchmarkWorkload(workload);
+  buildZipfWorkload(workload, testPaths, TEST_DATA_SIZE, WORKLOAD_ZIPF_EXPONENT, WORKLOAD_SEED);
+  benchmarkWorkload(workload);
+  buildShiftingWorkload(workload, testPaths, TEST_DATA_SIZE, WORKLOAD_ZIPF_EXPONENT, WORKLOAD_PHASES, WORKLOAD_SEED);
+  benchmarkWorkload(workload);
+  buildEmbeddedTraceWorkload(workload);
+  benchmarkWorkload(workload);
+  buildSequentialWorkload(workload, deepPaths, DEEP_PATH_COUNT);
+  workload.name = "deep paths + query strings";
+  benchmarkWorkload(workload);
+#if defined(BENCH_NATIVE)
+  const char *traceFile = getenv("BENCH_TRACE");
+#else
+  const char *traceFile = TRACE_FILE;
+#endif
+  if (traceFile && loadTraceWorkload(workload, traceFile))
+  {
+    benchmarkWorkload(workload);
+  }
+  printAdaptiveResolverStats();
+
+  // Step 7: Additional system info
   Serial.println("=== SYSTEM INFORMATION ===");
   Serial.printf("ESP32 Chip: %s\n", ESP.getChipModel());
   Serial.printf("Chip Revision: %d\n", ESP.getChipRevision());
@@ -561,44 +1984,8 @@ void setup()
 
 void loop()
 {
-  // Optional: Run continuous mini-benchmark
-  static unsigned long lastBenchmark = 0;
-
-  if (millis() - lastBenchmark > 30000)
-  { // Every 30 seconds
-    lastBenchmark = millis();
-
-    Serial.println("\n--- Quick Benchmark ---");
-
-    String testPath = "example.css";
-
-    // Quick test - 10000 iterations
-    uint64_t start1 = getMicros();
-    for (int i = 0; i < 10000; i++)
-    {
-      _setContentTypeFromPath_v1(testPath);
-    }
-    uint64_t time1 = getMicros() - start1;
-
-    uint64_t start2 = getMicros();
-    for (int i = 0; i < 10000; i++)
-    {
-      _setContentTypeFromPath_v2(testPath);
-    }
-    uint64_t time2 = getMicros() - start2;
-
-    uint64_t start3 = getMicros();
-    for (int i = 0; i < 10000; i++)
-    {
-      _setContentTypeFromPath_v3(testPath);
-    }
-    uint64_t time3 = getMicros() - start3;
-
-    Serial.printf("V1: %0.5f μs/call, V2: %0.5f μs/call, V3: %0.5f μs/call\n",
-                  (float)time1 / 10000, (float)time2 / 10000, (float)time3 / 10000);
-    Serial.printf("V2 speedup: %0.2fx, V3 speedup: %0.2fx\n",
-                  (float)time1 / time2, (float)time1 / time3);
-  }
+  // Reports the calls made by the application through resolveContentType()
+  telemetryPoll(TELEMETRY_REPORT_INTERVAL_MS);
 
   delay(1000);
-}
\ No newline at end of file
+}
@@ -0,0 +1,117 @@
+#include "mime_batch.h"
+
+#include <string.h>
+
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "Tail words assume a little endian CPU");
+static_assert(MIME_EXT_MAX_LEN < 8, "An extension and its dot must fit in one 64-bit key");
+
+#define SWAR_LOW7 0x7F7F7F7F7F7F7F7Full
+#define SWAR_ONES 0x0101010101010101ull
+
+/**
+ * @brief Extension bytes, dot included, in the low bytes of a zero padded word
+ */
+static constexpr uint64_t extensionKey(const char *ext, size_t len)
+{
+  uint64_t key = 0;
+  for (size_t i = 0; i < len; i++)
+    key |= (uint64_t)(uint8_t)ext[i] << (8 * i);
+  return key;
+}
+
+struct BatchSlot
+{
+  uint64_t key; // extensionKey() of the slot extension, 0 = empty slot
+  uint8_t len;
+  uint8_t index;
+};
+
+struct BatchTable
+{
+  BatchSlot slots[MIME_HASH_SLOTS];
+};
+
+static constexpr BatchTable buildBatchTable()
+{
+  BatchTable table = {};
+  for (size_t i = 0; i < MIME_HASH_SLOTS; i++)
+  {
+    const MimeSlot &slot = mimeHashTable.slots[i];
+    table.slots[i].index = MIME_INDEX_NONE;
+    if (slot.len)
+    {
+      table.slots[i].key = extensionKey(slot.ext, slot.len);
+      table.slots[i].len = slot.len;
+      table.slots[i].index = slot.index;
+    }
+  }
+  return table;
+}
+
+static constexpr BatchTable batchTable = buildBatchTable();
+
+/**
+ * @brief Last 8 bytes of the path, byte 7 = last character, zero padded when shorter
+ */
+static inline uint64_t tailWord(const PathView &path)
+{
+  uint64_t word = 0;
+  if (path.len >= 8)
+  {
+    memcpy(&word, path.data + path.len - 8, 8);
+    return word;
+  }
+  unsigned char padded[8] = {};
+  memcpy(padded + 8 - path.len, path.data, path.len);
+  memcpy(&word, padded, 8);
+  return word;
+}
+
+/**
+ * @brief 0x80 in every byte of word equal to c, 0 elsewhere (exact, no false positives)
+ */
+static inline uint64_t matchBytes(uint64_t word, char c)
+{
+  uint64_t x = word ^ (SWAR_ONES * (uint8_t)c);
+  return ~(((x & SWAR_LOW7) + SWAR_LOW7) | x | SWAR_LOW7);
+}
+
+void mimeIndicesFor(const PathView *paths, size_t count, uint8_t *indices)
+{
+  uint64_t keys[MIME_BATCH_LANES];
+  uint32_t lens[MIME_BATCH_LANES];
+  uint32_t slots[MIME_BATCH_LANES];
+
+  for (size_t base = 0; base < count; base += MIME_BATCH_LANES)
+  {
+    size_t lanes = count - base < MIME_BATCH_LANES ? count - base : MIME_BATCH_LANES;
+
+    // Stage 1: locate the last dot in each tail word, reject a '/' after it
+    for (size_t i = 0; i < lanes; i++)
+    {
+      uint64_t tail = tailWord(paths[base + i]);
+      uint64_t dots = matchBytes(tail, '.');
+      uint64_t slashes = matchBytes(tail, '/');
+      int dotByte = dots ? (63 - __builtin_clzll(dots)) >> 3 : 0;
+      uint64_t dotBit = dots ? 1ull << (dotByte * 8 + 7) : 0;
+      bool valid = dots && !(slashes & ~(dotBit * 2 - 1)) && dotByte < 7;
+
+      keys[i] = tail >> (8 * dotByte);
+      lens[i] = valid ? 8 - dotByte : 0;
+    }
+
+    // Stage 2: hash on length, first and last extension character
+    for (size_t i = 0; i < lanes; i++)
+    {
+      uint32_t last = lens[i] ? lens[i] - 1 : 0;
+      slots[i] = mimeHash((char)(keys[i] >> 8), (char)(keys[i] >> (8 * last)), lens[i], MIME_HASH_SEED);
+    }
+
+    // Stage 3: one 64-bit compare against the slot
+    for (size_t i = 0; i < lanes; i++)
+    {
+      const BatchSlot &slot = batchTable.slots[slots[i]];
+      indices[base + i] = (slot.key == keys[i] && slot.len == lens[i]) ? slot.index : (uint8_t)MIME_INDEX_NONE;
+    }
+  }
+}
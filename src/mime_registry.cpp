@@ -0,0 +1,206 @@
+#include "mime_registry.h"
+
+#if defined(BENCH_NATIVE)
+#include <stdio.h>
+#else
+#include <LittleFS.h>
+#endif
+
+/**
+ * @brief len characters packed little endian, the same layout for added extensions and looked up paths
+ */
+static inline uint64_t packSlice(const char *chars, size_t len)
+{
+  uint64_t key = 0;
+  for (size_t i = 0; i < len; i++)
+    key |= (uint64_t)(uint8_t)chars[i] << (8 * i);
+  return key;
+}
+
+/**
+ * @brief Grow a heap array to hold at least needed elements, doubling its capacity
+ */
+template <typename T>
+static bool reserve(T *&array, size_t &capacity, size_t needed)
+{
+  if (needed <= capacity)
+    return true;
+  size_t grown = capacity ? capacity : 16;
+  while (grown < needed)
+    grown *= 2;
+  T *resized = (T *)realloc(array, grown * sizeof(T));
+  if (!resized)
+    return false;
+  array = resized;
+  capacity = grown;
+  return true;
+}
+
+/**
+ * @brief Pooled copy of mime, shared by every extension mapped to it
+ * @return nullptr when out of memory
+ */
+const char *MimeRegistry::intern(const char *mime)
+{
+  for (MimePoolChunk *chunk = _pool; chunk; chunk = chunk->next)
+  {
+    for (size_t at = 0; at < chunk->used; at += strlen(chunk->data + at) + 1)
+    {
+      if (strcmp(chunk->data + at, mime) == 0)
+        return chunk->data + at;
+    }
+  }
+
+  // A new chunk instead of a realloc: strings already handed out must not move
+  size_t len = strlen(mime) + 1;
+  if (!_pool || _pool->capacity - _pool->used < len)
+  {
+    size_t capacity = len > MIME_POOL_CHUNK_SIZE ? len : MIME_POOL_CHUNK_SIZE;
+    MimePoolChunk *chunk = (MimePoolChunk *)malloc(sizeof(MimePoolChunk) + capacity);
+    if (!chunk)
+      return nullptr;
+    chunk->next = _pool;
+    chunk->used = 0;
+    chunk->capacity = capacity;
+    _pool = chunk;
+    _poolBytes += sizeof(MimePoolChunk) + capacity;
+  }
+  char *copy = _pool->data + _pool->used;
+  memcpy(copy, mime, len);
+  _pool->used += len;
+  return copy;
+}
+
+bool MimeRegistry::add(const char *ext, const char *mime)
+{
+  if (*ext == '.')
+    ext++;
+  size_t len = strlen(ext);
+  if (len == 0 || len > MIME_OVERFLOW_EXT_MAX || strpbrk(ext, "./") || !mime || !*mime)
+    return false;
+
+  // Built-ins are immutable
+  char dotted[MIME_OVERFLOW_EXT_MAX + 2] = ".";
+  memcpy(dotted + 1, ext, len + 1);
+  if (mimeIndexFor(dotted, len + 1) != MIME_INDEX_NONE)
+    return false;
+
+  const char *pooled = intern(mime);
+  if (!pooled)
+    return false;
+
+  uint64_t key = packSlice(ext, len);
+  size_t at = 0;
+  while (at < _count && _entries[at].key < key)
+    at++;
+  if (at < _count && _entries[at].key == key)
+  {
+    _entries[at].mime = pooled;
+    return true;
+  }
+
+  if (!reserve(_entries, _capacity, _count + 1))
+    return false;
+  memmove(_entries + at + 1, _entries + at, (_count - at) * sizeof(MimeOverflowEntry));
+  _entries[at] = {key, pooled};
+  _count++;
+  return true;
+}
+
+void MimeRegistry::clear()
+{
+  free(_entries);
+  while (_pool)
+  {
+    MimePoolChunk *next = _pool->next;
+    free(_pool);
+    _pool = next;
+  }
+  _entries = nullptr;
+  _count = _capacity = _poolBytes = 0;
+}
+
+const char *MimeRegistry::lookupOverflow(const char *path, size_t len) const
+{
+  // Bounded reverse scan, as findExtension() but for the longer added extensions
+  const char *end = path + len;
+  const char *p = end;
+  const char *stop = len > MIME_OVERFLOW_EXT_MAX + 1 ? end - (MIME_OVERFLOW_EXT_MAX + 1) : path;
+  const char *dot = nullptr;
+  while (p > stop)
+  {
+    char c = *--p;
+    if (c == '.')
+    {
+      dot = p;
+      break;
+    }
+    if (c == '/')
+      break;
+  }
+  if (!dot || end - dot < 2)
+    return T_application_octet_stream;
+
+  uint64_t key = packSlice(dot + 1, (size_t)(end - dot - 1));
+
+  // Branchless binary search, as Version 5
+  const MimeOverflowEntry *base = _entries;
+  size_t n = _count;
+  while (n > 1)
+  {
+    size_t half = n / 2;
+    base = (base[half].key <= key) ? base + half : base;
+    n -= half;
+  }
+  return base->key == key ? base->mime : T_application_octet_stream;
+}
+
+/**
+ * @brief Add the mapping of one "ext mime/type" line
+ */
+static bool addLine(MimeRegistry &registry, char *line)
+{
+  line[strcspn(line, "#\r\n")] = '\0';
+  char *ext = strtok(line, " \t");
+  char *mime = ext ? strtok(nullptr, " \t") : nullptr;
+  return mime && registry.add(ext, mime);
+}
+
+int MimeRegistry::load(const char *filename)
+{
+  char line[160];
+  int added = 0;
+
+#if defined(BENCH_NATIVE)
+  FILE *file = fopen(filename, "r");
+  if (!file)
+    return -1;
+  while (fgets(line, sizeof(line), file))
+  {
+    added += addLine(*this, line) ? 1 : 0;
+  }
+  fclose(file);
+#else
+  if (!LittleFS.begin(false))
+    return -1;
+  File file = LittleFS.open(filename, "r");
+  if (!file)
+    return -1;
+  while (file.available())
+  {
+    size_t len = file.readBytesUntil('\n', line, sizeof(line) - 1);
+    line[len] = '\0';
+    added += addLine(*this, line) ? 1 : 0;
+  }
+  file.close();
+#endif
+
+  return added;
+}
+
+static MimeRegistry registry;
+
+MimeRegistry &mimeRegistry()
+{
+  return registry;
+}
@@ -0,0 +1,173 @@
+#include "parallel_bench.h"
+
+#include <atomic>
+#include <esp_timer.h>
+
+#if defined(BENCH_NATIVE)
+#include <thread>
+#else
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#endif
+
+#define PARALLEL_TASK_STACK 4096 // Bytes (ESP32 worker tasks)
+#define PARALLEL_TASK_PRIORITY 1 // Same as loopTask, so time slicing lets it run on its core
+
+struct alignas(64) ParallelSink
+{
+  std::atomic<const char *> value;
+};
+
+struct ParallelShared
+{
+  ParallelResolverFn func;
+  const String *paths;
+  int pathCount;
+  int iterations;
+  bool sharedSink;
+  std::atomic<int> ready;
+  std::atomic<bool> go;
+  ParallelSink sink; // Used by all workers when sharedSink is set
+#if !defined(BENCH_NATIVE)
+  SemaphoreHandle_t done;
+#endif
+};
+
+struct alignas(64) ParallelWorker
+{
+  ParallelShared *shared;
+  int64_t elapsed; // μs
+  ParallelSink sink;
+};
+
+/**
+ * @brief Let the thread that releases the barrier run, even on a single core
+ */
+static inline void parallelYield()
+{
+#if defined(BENCH_NATIVE)
+  std::this_thread::yield();
+#else
+  taskYIELD();
+#endif
+}
+
+static void runWorker(ParallelWorker &worker)
+{
+  ParallelShared &shared = *worker.shared;
+  ParallelResolverFn func = shared.func;
+  std::atomic<const char *> &sink = shared.sharedSink ? shared.sink.value : worker.sink.value;
+
+  // Start barrier
+  shared.ready.fetch_add(1);
+  while (!shared.go.load(std::memory_order_acquire))
+  {
+    parallelYield();
+  }
+
+  int64_t start = esp_timer_get_time();
+  int index = 0;
+  for (int iter = 0; iter < shared.iterations; iter++)
+  {
+    const String &path = shared.paths[index];
+    sink.store(func(path.c_str(), path.length()), std::memory_order_relaxed);
+    if (++index == shared.pathCount)
+      index = 0;
+  }
+  worker.elapsed = esp_timer_get_time() - start;
+}
+
+#if !defined(BENCH_NATIVE)
+static void workerTask(void *arg)
+{
+  ParallelWorker &worker = *(ParallelWorker *)arg;
+  runWorker(worker);
+  xSemaphoreGive(worker.shared->done);
+  vTaskDelete(NULL);
+}
+#endif
+
+int parallelMaxWorkers()
+{
+#if defined(BENCH_NATIVE)
+  int threads = (int)std::thread::hardware_concurrency();
+  threads = threads < 1 ? 1 : threads;
+#else
+  int threads = portNUM_PROCESSORS;
+#endif
+  return threads > PARALLEL_MAX_WORKERS ? PARALLEL_MAX_WORKERS : threads;
+}
+
+bool benchmarkParallel(ParallelResolverFn func, const String paths[], int pathCount, int iterations, int workers,
+                       bool sharedSink, ParallelResult &result)
+{
+  ParallelShared shared;
+  ParallelWorker worker[PARALLEL_MAX_WORKERS];
+
+  workers = workers > PARALLEL_MAX_WORKERS ? PARALLEL_MAX_WORKERS : (workers < 1 ? 1 : workers);
+  shared.func = func;
+  shared.paths = paths;
+  shared.pathCount = pathCount;
+  shared.iterations = iterations;
+  shared.sharedSink = sharedSink;
+  shared.ready.store(0);
+  shared.go.store(false);
+
+#if defined(BENCH_NATIVE)
+  std::thread threads[PARALLEL_MAX_WORKERS];
+  for (int i = 0; i < workers; i++)
+  {
+    worker[i].shared = &shared;
+    worker[i].elapsed = 0;
+    threads[i] = std::thread(runWorker, std::ref(worker[i]));
+  }
+  while (shared.ready.load() < workers)
+  {
+    parallelYield();
+  }
+  int64_t start = esp_timer_get_time();
+  shared.go.store(true, std::memory_order_release);
+  for (int i = 0; i < workers; i++)
+  {
+    threads[i].join();
+  }
+#else
+  shared.done = xSemaphoreCreateCounting(workers, 0);
+  if (!shared.done)
+    return false;
+  int started = 0;
+  for (; started < workers; started++)
+  {
+    worker[started].shared = &shared;
+    worker[started].elapsed = 0;
+    if (xTaskCreatePinnedToCore(workerTask, "benchWorker", PARALLEL_TASK_STACK, &worker[started],
+                                PARALLEL_TASK_PRIORITY, NULL, started % portNUM_PROCESSORS) != pdPASS)
+      break;
+  }
+  if (started < workers)
+    shared.iterations = 0; // Let the started workers through the barrier with nothing to do
+  while (shared.ready.load() < started)
+  {
+    vTaskDelay(1);
+  }
+  int64_t start = esp_timer_get_time();
+  shared.go.store(true, std::memory_order_release);
+  for (int i = 0; i < started; i++)
+  {
+    xSemaphoreTake(shared.done, portMAX_DELAY);
+  }
+  vSemaphoreDelete(shared.done);
+  if (started < workers)
+    return false;
+#endif
+  int64_t wall = esp_timer_get_time() - start;
+
+  result.workers = workers;
+  result.callsPerSecond = wall > 0 ? (double)iterations * workers * 1e6 / wall : 0;
+  for (int i = 0; i < workers; i++)
+  {
+    result.workerCallsPerSecond[i] = worker[i].elapsed > 0 ? (double)iterations * 1e6 / worker[i].elapsed : 0;
+  }
+  return true;
+}
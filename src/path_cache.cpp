@@ -0,0 +1,70 @@
+#include "path_cache.h"
+#include "mime_types.h"
+
+void _setContentTypeFromPath_v4(const String &path);
+
+// Paths with the same key must share an extension: the longest one, its dot
+// and the byte before it have to fit in the 8 key bytes.
+static_assert(MIME_EXT_MAX_LEN + 1 <= 8, "pathTailKey: the longest extension no longer fits in the 64-bit key");
+
+/**
+ * @brief Last 8 bytes of the path, zero padded on the left when shorter
+ */
+static inline uint64_t pathTailKey(const char *path, size_t len)
+{
+  uint64_t key = 0;
+  if (len >= 8)
+  {
+    memcpy(&key, path + len - 8, 8);
+    return key;
+  }
+  for (size_t i = 0; i < len; i++)
+    key = (key << 8) | (uint8_t)path[i];
+  return key;
+}
+
+static inline uint32_t slotOf(uint64_t key)
+{
+  uint32_t folded = (uint32_t)key ^ (uint32_t)(key >> 32);
+  return (folded * 0x9E3779B1u) >> (32 - __builtin_ctz(PATH_CACHE_SLOTS));
+}
+
+void PathCache::clear()
+{
+  memset(_slots, 0, sizeof(_slots));
+  resetStats();
+}
+
+void PathCache::resolve(const String &path)
+{
+  uint64_t key = pathTailKey(path.c_str(), path.length());
+  Slot &slot = _slots[slotOf(key)];
+
+  if (slot.key == key && slot.mime)
+  {
+    _stats.hits++;
+    _contentType = slot.mime;
+    return;
+  }
+
+  _stats.misses++;
+  _backend(path);
+  slot.key = key;
+  slot.mime = _contentType;
+}
+
+static PathCache cacheV7(_setContentTypeFromPath_v4);
+
+PathCache &version7Cache()
+{
+  return cacheV7;
+}
+
+/**
+ * @brief Version 4 behind a path memoization cache
+ */
+void _setContentTypeFromPath_v7(const String &path)
+{
+  cacheV7.resolve(path);
+}
+REGISTER_RESOLVER(_setContentTypeFromPath_v7, "Version 7", 7);
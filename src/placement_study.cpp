@@ -0,0 +1,349 @@
+#include "placement_study.h"
+#include "cycle_timer.h"
+#include "latency_histogram.h"
+#include "mime_dfa.h"
+#include "mime_hash.h"
+
+#include <esp_attr.h>
+
+#if defined(BENCH_NATIVE) || PLACEMENT_DEVICE_EVICTION
+#define PLACEMENT_COLD 1 // Cold measurements built
+#else
+#define PLACEMENT_COLD 0
+#endif
+
+#if !defined(BENCH_NATIVE) && PLACEMENT_DEVICE_EVICTION
+#include <esp_ota_ops.h>
+#include <esp_partition.h>
+#if CONFIG_IDF_TARGET_ESP32S3
+#include <esp32s3/rom/cache.h>
+#endif
+#endif
+
+#define PLACEMENT_SAMPLES 2000 // Timed calls per variant and cache state
+
+// ========================================
+// PLACED TABLES
+// ========================================
+//
+// Extensions are stored inline so a lookup never dereferences a pointer
+// into flash rodata. The MIME pointer is only returned, never read.
+
+struct PlacedSlot
+{
+  char ext[MIME_EXT_MAX_LEN + 2]; // Dot included, NUL padded
+  const char *mime;
+  uint8_t len; // 0 = empty slot
+};
+
+struct PlacedTable
+{
+  PlacedSlot hashed[MIME_HASH_SLOTS];  // Indexed by mimeHash()
+  PlacedSlot linear[MIME_TABLE_SIZE];  // mimeTable order
+};
+
+static constexpr PlacedSlot placeSlot(const char *ext, const char *mime)
+{
+  PlacedSlot slot = {};
+  size_t len = ext ? constLength(ext) : 0;
+  for (size_t i = 0; i < len; i++)
+    slot.ext[i] = ext[i];
+  slot.mime = mime;
+  slot.len = (uint8_t)len;
+  return slot;
+}
+
+static constexpr PlacedTable buildPlacedTable()
+{
+  PlacedTable table = {};
+  for (size_t i = 0; i < MIME_HASH_SLOTS; i++)
+    table.hashed[i] = placeSlot(mimeHashTable.slots[i].len ? mimeHashTable.slots[i].ext : nullptr,
+                                mimeHashTable.slots[i].mime);
+  for (size_t i = 0; i < MIME_TABLE_SIZE; i++)
+    table.linear[i] = placeSlot(mimeTable[i].ext, mimeTable[i].mime);
+  return table;
+}
+
+// Flash rodata, reached through the data cache
+static constexpr PlacedTable flashTable = buildPlacedTable();
+
+// Internal DRAM, never behind a cache
+DRAM_ATTR static const PlacedTable dramTable = buildPlacedTable();
+
+// Version 11 DFA: mimeDfa stays in flash rodata, this copy lives in DRAM
+DRAM_ATTR static const MimeDfa dramDfa = buildMimeDfa();
+
+// ========================================
+// LOOKUPS (inlined into each placed copy)
+// ========================================
+
+static inline __attribute__((always_inline)) bool placedEquals(const char *dot, const PlacedSlot &slot, size_t len)
+{
+  if (slot.len != len)
+    return false;
+  for (size_t i = 0; i < len; i++)
+  {
+    if (dot[i] != slot.ext[i])
+      return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Bounded reverse scan for the last dot, no library call
+ */
+static inline __attribute__((always_inline)) const char *placedExtension(const String &path, size_t &len)
+{
+  const char *begin = path.c_str();
+  const char *end = begin + path.length();
+  const char *limit = end - (path.length() < MIME_EXT_MAX_LEN ? path.length() : MIME_EXT_MAX_LEN);
+  for (const char *p = end - 1; p >= limit; p--)
+  {
+    if (*p == '.')
+    {
+      len = (size_t)(end - p);
+      return len >= 2 ? p : nullptr;
+    }
+    if (*p == '/')
+      return nullptr;
+  }
+  return nullptr;
+}
+
+static inline __attribute__((always_inline)) void placedHashLookup(const String &path, const PlacedTable &table)
+{
+  size_t len = 0;
+  const char *dot = placedExtension(path, len);
+  if (!dot)
+  {
+    _contentType = T_application_octet_stream;
+    return;
+  }
+  const PlacedSlot &slot = table.hashed[mimeHash(dot[1], dot[len - 1], len, MIME_HASH_SEED)];
+  _contentType = placedEquals(dot, slot, len) ? slot.mime : T_application_octet_stream;
+}
+
+static inline __attribute__((always_inline)) void placedLinearLookup(const String &path, const PlacedTable &table)
+{
+  size_t len = 0;
+  const char *dot = placedExtension(path, len);
+  if (dot)
+  {
+    for (size_t i = 0; i < MIME_TABLE_SIZE; i++)
+    {
+      if (placedEquals(dot, table.linear[i], len))
+      {
+        _contentType = table.linear[i].mime;
+        return;
+      }
+    }
+  }
+  _contentType = T_application_octet_stream;
+}
+
+/**
+ * @brief Version 11 DFA walk, MIME pointer taken from the linear slots of the same placement
+ */
+static inline __attribute__((always_inline)) void placedDfaLookup(const String &path, const MimeDfa &dfa,
+                                                                  const PlacedTable &table)
+{
+  size_t len = 0;
+  const char *dot = placedExtension(path, len);
+  uint8_t state = dot ? MIME_DFA_ROOT : MIME_DFA_DEAD;
+  for (size_t i = 1; i < len && state != MIME_DFA_DEAD; i++)
+    state = dfa.next[state][dfa.charClass[(uint8_t)dot[i]]];
+  uint8_t index = dfa.accept[state];
+  _contentType = index == MIME_INDEX_NONE ? T_application_octet_stream : table.linear[index].mime;
+}
+
+// ========================================
+// PLACED VARIANTS
+// ========================================
+
+static void __attribute__((noinline)) hashFlash(const String &path) { placedHashLookup(path, flashTable); }
+static void IRAM_ATTR __attribute__((noinline)) hashIram(const String &path) { placedHashLookup(path, dramTable); }
+static void __attribute__((noinline)) linearFlash(const String &path) { placedLinearLookup(path, flashTable); }
+static void IRAM_ATTR __attribute__((noinline)) linearIram(const String &path) { placedLinearLookup(path, dramTable); }
+static void __attribute__((noinline)) dfaFlash(const String &path) { placedDfaLookup(path, mimeDfa, flashTable); }
+static void IRAM_ATTR __attribute__((noinline)) dfaIram(const String &path) { placedDfaLookup(path, dramDfa, dramTable); }
+
+struct PlacedVariant
+{
+  const char *name;
+  void (*func)(const String &);
+};
+
+static const PlacedVariant placedVariants[] = {
+    {"perfect hash, flash", hashFlash},
+    {"perfect hash, IRAM+DRAM", hashIram},
+    {"linear scan, flash", linearFlash},
+    {"linear scan, IRAM+DRAM", linearIram},
+    {"DFA (Version 11), flash", dfaFlash},
+    {"DFA (Version 11), IRAM+DRAM", dfaIram},
+};
+
+#define PLACED_VARIANT_COUNT (sizeof(placedVariants) / sizeof(placedVariants[0]))
+
+// ========================================
+// CACHE EVICTION
+// ========================================
+//
+// Data: read a region larger than the data cache, one load per cache
+// line. On the ESP32 the region is the running app image itself, mapped
+// through the data cache, so the study adds no flash of its own.
+// Instructions: the ESP32-S3 instruction cache holds no dirty lines, so
+// it is simply invalidated with the ROM call. The data cache is not: it
+// may hold PSRAM writes, which an invalidation would lose.
+
+#if PLACEMENT_COLD
+#define EVICT_LINE_BYTES 32
+
+#if defined(BENCH_NATIVE)
+#define EVICT_DATA_BYTES (8 * 1024 * 1024) // Past L2 of a typical host
+
+static uint8_t evictionBuffer[EVICT_DATA_BYTES]; // Filled by mapEvictionRegion(), untouched bss pages all map one zero page
+#else
+#define EVICT_DATA_BYTES (128 * 1024) // Twice the largest ESP32-S3 data cache
+#endif
+
+static const uint8_t *evictionData = nullptr;
+static size_t evictionBytes = 0;
+
+/**
+ * @brief Find the region read by evictCaches()
+ * @note ESP32: the mapping of the app partition is kept for the rest of the run (two 64 KB MMU pages)
+ */
+static bool mapEvictionRegion()
+{
+  if (evictionData)
+    return true;
+#if defined(BENCH_NATIVE)
+  memset(evictionBuffer, 0x5A, sizeof(evictionBuffer));
+  evictionData = evictionBuffer;
+  evictionBytes = sizeof(evictionBuffer);
+#else
+  const esp_partition_t *app = esp_ota_get_running_partition();
+  if (!app)
+    return false;
+  evictionBytes = app->size < EVICT_DATA_BYTES ? app->size : EVICT_DATA_BYTES;
+  const void *mapped = nullptr;
+  spi_flash_mmap_handle_t handle;
+  if (esp_partition_mmap(app, 0, evictionBytes, ESP_PARTITION_MMAP_DATA, &mapped, &handle) != ESP_OK)
+    return false;
+  evictionData = (const uint8_t *)mapped;
+#endif
+  return true;
+}
+
+static void __attribute__((noinline)) evictCaches()
+{
+  const volatile uint8_t *data = evictionData;
+  uint32_t sum = 0;
+  for (size_t i = 0; i < evictionBytes; i += EVICT_LINE_BYTES)
+    sum += data[i];
+  asm volatile("" ::"r"(sum));
+
+#if !defined(BENCH_NATIVE) && CONFIG_IDF_TARGET_ESP32S3
+  Cache_Invalidate_ICache_All();
+#endif
+}
+#endif
+
+// ========================================
+// STUDY
+// ========================================
+
+/**
+ * @brief Time PLACEMENT_SAMPLES calls of func, evicting the caches before each one when cold is set
+ */
+static void measurePlacement(void (*func)(const String &), const String paths[], int pathCount, bool cold,
+                             uint32_t overhead, LatencyHistogram &histogram)
+{
+  histogram.reset();
+  for (int i = 0; i < pathCount; i++)
+    func(paths[i]);
+
+  for (int i = 0; i < PLACEMENT_SAMPLES; i++)
+  {
+    const String &path = paths[i % pathCount];
+#if PLACEMENT_COLD
+    if (cold)
+      evictCaches();
+#endif
+    uint32_t start = readCycles();
+
+    func(path);
+    asm volatile("" ::"m"(_contentType) : "memory");
+
+    uint32_t cycles = readCycles() - start;
+    histogram.record(cycles > overhead ? cycles - overhead : 0);
+  }
+}
+
+bool runPlacementStudy(const String paths[], int pathCount)
+{
+  Serial.println("=== IRAM/DRAM vs FLASH PLACEMENT ===");
+
+  for (size_t v = 0; v < PLACED_VARIANT_COUNT; v++)
+  {
+    for (int i = 0; i < pathCount; i++)
+    {
+      placedVariants[v].func(paths[i]);
+      if (strcmp(_contentType, contentTypeFor(paths[i].c_str(), paths[i].length())) != 0)
+      {
+        Serial.printf("❌ %s: wrong type for %s\n", placedVariants[v].name, paths[i].c_str());
+        return false;
+      }
+    }
+  }
+
+  static LatencyHistogram hot;
+  uint32_t overhead = readCyclesOverhead();
+
+  Serial.printf("Tables: %u + %u bytes in flash rodata, %u + %u bytes in DRAM\n", (unsigned)sizeof(flashTable),
+                (unsigned)sizeof(mimeDfa), (unsigned)sizeof(dramTable), (unsigned)sizeof(dramDfa));
+#if PLACEMENT_COLD
+  if (!mapEvictionRegion())
+  {
+    Serial.println("❌ No flash region to evict the caches with");
+    return false;
+  }
+
+  static LatencyHistogram cold;
+  uint32_t cyclesPerMicro = cyclesPerMicrosecond();
+
+#if defined(BENCH_NATIVE)
+  const char *evictedInstructions = "no instruction cache eviction";
+#elif CONFIG_IDF_TARGET_ESP32S3
+  const char *evictedInstructions = "instruction cache invalidated";
+#else
+  const char *evictedInstructions = "no instruction cache eviction on this chip";
+#endif
+  Serial.printf("Per-call cycles, %d calls each; cold = %u KB of data read (%s) before every call\n",
+                PLACEMENT_SAMPLES, (unsigned)(evictionBytes / 1024), evictedInstructions);
+  Serial.printf("  %-30s %8s %8s %8s %8s %10s\n", "variant", "hot p50", "hot p99", "cold p50", "cold p99",
+                "cold ns");
+  for (size_t v = 0; v < PLACED_VARIANT_COUNT; v++)
+  {
+    measurePlacement(placedVariants[v].func, paths, pathCount, false, overhead, hot);
+    measurePlacement(placedVariants[v].func, paths, pathCount, true, overhead, cold);
+    Serial.printf("  %-30s %8u %8u %8u %8u %10.1f\n", placedVariants[v].name, hot.percentile(0.50),
+                  hot.percentile(0.99), cold.percentile(0.50), cold.percentile(0.99),
+                  cold.percentile(0.50) * 1000.0 / cyclesPerMicro);
+  }
+#if defined(BENCH_NATIVE)
+  Serial.println("  (host build: IRAM_ATTR/DRAM_ATTR are no-ops, both placements run from the same memory)");
+#endif
+#else
+  Serial.printf("Per-call cycles, %d calls each, warm caches (cold runs: build with -DPLACEMENT_DEVICE_EVICTION=1)\n",
+                PLACEMENT_SAMPLES);
+  Serial.printf("  %-30s %8s %8s\n", "variant", "hot p50", "hot p99");
+  for (size_t v = 0; v < PLACED_VARIANT_COUNT; v++)
+  {
+    measurePlacement(placedVariants[v].func, paths, pathCount, false, overhead, hot);
+    Serial.printf("  %-30s %8u %8u\n", placedVariants[v].name, hot.percentile(0.50), hot.percentile(0.99));
+  }
+#endif
+  Serial.println();
+  return true;
+}
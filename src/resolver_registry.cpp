@@ -0,0 +1,27 @@
+#include "resolver_registry.h"
+
+// Zero-initialized, so it is valid before any registrar constructor runs
+static ResolverCandidate registry[RESOLVER_REGISTRY_MAX];
+static int registryCount;
+
+bool registerResolver(const char *name, ResolverFn func, int order, uint8_t flags)
+{
+  if (registryCount >= RESOLVER_REGISTRY_MAX)
+    return false;
+
+  int i = registryCount++;
+  for (; i > 0 && registry[i - 1].order > order; i--)
+    registry[i] = registry[i - 1];
+  registry[i] = {name, func, order, flags};
+  return true;
+}
+
+int resolverCount()
+{
+  return registryCount;
+}
+
+const ResolverCandidate &resolverAt(int index)
+{
+  return registry[index];
+}
@@ -0,0 +1,141 @@
+#include "resolver_telemetry.h"
+
+#include <atomic>
+
+TelemetryCounters telemetryCounters[TELEMETRY_MAX_CORES];
+TelemetryCounter telemetryEpoch(0);
+
+// Counters at the last report, read by the collector only
+struct TelemetrySnapshot
+{
+  uint32_t counts[MIME_TABLE_SIZE + 1];
+  uint32_t samples;
+  uint32_t sampledCycles;
+};
+
+static TelemetrySnapshot previous[TELEMETRY_MAX_CORES];
+static uint32_t previousMs = 0;
+static uint32_t lastPollMs = 0;
+static TelemetryCallback reportCallback = nullptr;
+
+int telemetryAssignSlot()
+{
+  static std::atomic<int> nextSlot(0);
+  return nextSlot.fetch_add(1) % TELEMETRY_MAX_CORES;
+}
+
+void __attribute__((noinline, cold)) telemetrySampleLookup(TelemetryCounters &counters, const char *path, size_t len)
+{
+  uint32_t start = readCycles();
+  uint8_t index = mimeIndexFor(path, len);
+  asm volatile("" ::"r"(index));
+  uint32_t cycles = readCycles() - start;
+
+  telemetryAdd(counters.samples, 1);
+  telemetryAdd(counters.sampledCycles, cycles);
+  uint32_t epoch = telemetryEpoch.load(std::memory_order_relaxed);
+  if (counters.maxEpoch.load(std::memory_order_relaxed) != epoch ||
+      cycles > counters.maxCycles.load(std::memory_order_relaxed))
+  {
+    counters.maxCycles.store(cycles, std::memory_order_relaxed);
+    counters.maxEpoch.store(epoch, std::memory_order_release); // Published after the value it covers
+  }
+}
+
+void telemetryCollect(TelemetryReport &report)
+{
+  static uint32_t overhead = readCyclesOverhead(); // Cost of the two counter reads around a timed call
+  uint32_t now = millis();
+  uint32_t epoch = telemetryEpoch.load(std::memory_order_relaxed);
+  uint64_t cycles = 0;
+
+  memset(&report, 0, sizeof(report));
+  report.intervalMs = now - previousMs;
+  previousMs = now;
+
+  for (int core = 0; core < TELEMETRY_MAX_CORES; core++)
+  {
+    const TelemetryCounters &live = telemetryCounters[core];
+    TelemetrySnapshot &last = previous[core];
+    TelemetrySnapshot snapshot;
+
+    // Counters wrap: differences of 32-bit values stay right across one wrap per report
+    uint32_t calls = 0;
+    for (size_t i = 0; i <= MIME_TABLE_SIZE; i++)
+    {
+      snapshot.counts[i] = live.counts[i].load(std::memory_order_relaxed);
+      calls += snapshot.counts[i] - last.counts[i];
+    }
+    snapshot.samples = live.samples.load(std::memory_order_relaxed);
+    snapshot.sampledCycles = live.sampledCycles.load(std::memory_order_relaxed);
+
+    report.callsPerCore[core] = calls;
+    report.calls += calls;
+    for (size_t i = 0; i < MIME_TABLE_SIZE; i++)
+      report.hits[i] += snapshot.counts[i] - last.counts[i];
+    report.misses += snapshot.counts[MIME_TABLE_SIZE] - last.counts[MIME_TABLE_SIZE];
+    report.samples += snapshot.samples - last.samples;
+    cycles += snapshot.sampledCycles - last.sampledCycles;
+
+    // Only a max written during this report counts, the owner resets it on the next epoch
+    if (live.maxEpoch.load(std::memory_order_acquire) == epoch)
+    {
+      uint32_t slowest = live.maxCycles.load(std::memory_order_relaxed);
+      report.maxCycles = slowest > report.maxCycles ? slowest : report.maxCycles;
+    }
+    last = snapshot;
+  }
+  // A sample racing with this increment may land in either report, or lose its max
+  telemetryEpoch.store(epoch + 1, std::memory_order_relaxed);
+
+  double mean = report.samples ? (double)cycles / report.samples : 0;
+  report.meanCycles = mean > overhead ? mean - overhead : 0;
+  report.maxCycles = report.maxCycles > overhead ? report.maxCycles - overhead : 0;
+}
+
+void setTelemetryCallback(TelemetryCallback callback)
+{
+  reportCallback = callback;
+}
+
+void telemetryPoll(uint32_t intervalMs)
+{
+  if (millis() - lastPollMs < intervalMs)
+    return;
+  lastPollMs = millis();
+
+  TelemetryReport report;
+  telemetryCollect(report);
+  if (reportCallback)
+    reportCallback(report);
+  else
+    printTelemetryReport(report);
+}
+
+void printTelemetryReport(const TelemetryReport &report)
+{
+  // Three most requested types
+  int top[3] = {-1, -1, -1};
+  for (int i = 0; i < (int)MIME_TABLE_SIZE; i++)
+  {
+    for (int rank = 0; rank < 3; rank++)
+    {
+      if (report.hits[i] && (top[rank] < 0 || report.hits[i] > report.hits[top[rank]]))
+      {
+        for (int shift = 2; shift > rank; shift--)
+          top[shift] = top[shift - 1];
+        top[rank] = i;
+        break;
+      }
+    }
+  }
+
+  Serial.printf("[telemetry] %u calls in %u ms, %0.1f%% unknown, %0.1f cycles mean / %u max (%u samples), top:",
+                report.calls, report.intervalMs, report.calls ? report.misses * 100.0 / report.calls : 0.0,
+                report.meanCycles, report.maxCycles, report.samples);
+  for (int rank = 0; rank < 3 && top[rank] >= 0; rank++)
+  {
+    Serial.printf(" %s %0.0f%%", mimeTable[top[rank]].ext, report.hits[top[rank]] * 100.0 / report.calls);
+  }
+  Serial.println();
+}
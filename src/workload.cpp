@@ -0,0 +1,173 @@
+#include "workload.h"
+#include "access_trace.h"
+
+#include <math.h>
+
+#if defined(BENCH_NATIVE)
+#include <stdio.h>
+#else
+#include <LittleFS.h>
+#endif
+
+/**
+ * @brief Deterministic xorshift32 so every run replays the same requests
+ */
+static uint32_t nextRandom(uint32_t &state)
+{
+  state ^= state << 13;
+  state ^= state >> 17;
+  state ^= state << 5;
+  return state;
+}
+
+static void resetWorkload(Workload &workload, const char *name, const char *const paths[], int count)
+{
+  count = count > WORKLOAD_MAX_PATHS ? WORKLOAD_MAX_PATHS : count;
+  workload.name = name;
+  workload.pathCount = count;
+  for (int i = 0; i < count; i++)
+  {
+    workload.paths[i] = paths[i];
+  }
+  workload.length = 0;
+}
+
+void buildSequentialWorkload(Workload &workload, const char *const paths[], int count)
+{
+  resetWorkload(workload, "sequential", paths, count);
+  workload.length = WORKLOAD_MAX_LENGTH - WORKLOAD_MAX_LENGTH % workload.pathCount;
+  for (int i = 0; i < workload.length; i++)
+  {
+    workload.sequence[i] = (uint8_t)(i % workload.pathCount);
+  }
+}
+
+void buildUniformWorkload(Workload &workload, const char *const paths[], int count, uint32_t seed)
+{
+  buildSequentialWorkload(workload, paths, count);
+  workload.name = "shuffled uniform";
+
+  // Fisher-Yates
+  uint32_t state = seed | 1;
+  for (int i = workload.length - 1; i > 0; i--)
+  {
+    int j = (int)(nextRandom(state) % (uint32_t)(i + 1));
+    uint8_t swap = workload.sequence[i];
+    workload.sequence[i] = workload.sequence[j];
+    workload.sequence[j] = swap;
+  }
+}
+
+void buildZipfWorkload(Workload &workload, const char *const paths[], int count, double exponent, uint32_t seed)
+{
+  resetWorkload(workload, "zipf", paths, count);
+
+  double cumulative[WORKLOAD_MAX_PATHS];
+  double total = 0;
+  for (int k = 0; k < workload.pathCount; k++)
+  {
+    total += 1.0 / pow(k + 1, exponent);
+    cumulative[k] = total;
+  }
+
+  uint32_t state = seed | 1;
+  workload.length = WORKLOAD_MAX_LENGTH;
+  for (int i = 0; i < workload.length; i++)
+  {
+    double draw = (double)nextRandom(state) / 4294967296.0 * total;
+    int k = 0;
+    while (k < workload.pathCount - 1 && cumulative[k] < draw)
+      k++;
+    workload.sequence[i] = (uint8_t)k;
+  }
+}
+
+void buildShiftingWorkload(Workload &workload, const char *const paths[], int count, double exponent, int phases,
+                           uint32_t seed)
+{
+  buildZipfWorkload(workload, paths, count, exponent, seed);
+  workload.name = "shifting zipf";
+
+  // Rotate the ranking by count / phases paths in every phase
+  int phaseLength = workload.length / phases;
+  for (int i = 0; i < workload.length; i++)
+  {
+    int shift = (i / phaseLength) * workload.pathCount / phases;
+    workload.sequence[i] = (uint8_t)((workload.sequence[i] + shift) % workload.pathCount);
+  }
+}
+
+void buildEmbeddedTraceWorkload(Workload &workload)
+{
+  resetWorkload(workload, "embedded trace", accessTracePaths, ACCESS_TRACE_PATHS);
+  workload.length = ACCESS_TRACE_LENGTH > WORKLOAD_MAX_LENGTH ? WORKLOAD_MAX_LENGTH : ACCESS_TRACE_LENGTH;
+  memcpy(workload.sequence, accessTraceSequence, workload.length);
+}
+
+/**
+ * @brief Append the request of one trace line to the workload
+ */
+static void addTraceLine(Workload &workload, char *line)
+{
+  // Access log line: take the URL of "METHOD /url HTTP/x"
+  char *path = line;
+  char *quote = strchr(line, '"');
+  if (quote)
+  {
+    path = strchr(quote, ' ');
+    if (!path)
+      return;
+    path++;
+  }
+  while (*path == ' ' || *path == '\t')
+    path++;
+  if (*path != '/')
+    return;
+  path[strcspn(path, "?# \t\r\n\"")] = '\0';
+
+  int index = 0;
+  while (index < workload.pathCount && !(workload.paths[index] == path))
+    index++;
+  if (index == workload.pathCount)
+  {
+    if (workload.pathCount == WORKLOAD_MAX_PATHS)
+      return;
+    workload.paths[workload.pathCount++] = path;
+  }
+  workload.sequence[workload.length++] = (uint8_t)index;
+}
+
+bool loadTraceWorkload(Workload &workload, const char *filename)
+{
+  char line[512];
+
+  workload.name = filename;
+  workload.pathCount = 0;
+  workload.length = 0;
+
+#if defined(BENCH_NATIVE)
+  FILE *file = fopen(filename, "r");
+  if (!file)
+    return false;
+  while (workload.length < WORKLOAD_MAX_LENGTH && fgets(line, sizeof(line), file))
+  {
+    addTraceLine(workload, line);
+  }
+  fclose(file);
+#else
+  if (!LittleFS.begin(false))
+    return false;
+  File file = LittleFS.open(filename, "r");
+  if (!file)
+    return false;
+  while (workload.length < WORKLOAD_MAX_LENGTH && file.available())
+  {
+    size_t len = file.readBytesUntil('\n', line, sizeof(line) - 1);
+    line[len] = '\0';
+    addTraceLine(workload, line);
+  }
+  file.close();
+#endif
+
+  return workload.length > 0;
+}
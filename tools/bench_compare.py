@@ -0,0 +1,148 @@
+#!/usr/bin/env python3
+"""Store benchmark results as a baseline and flag regressions against it.
+
+Reads the BENCH lines (see include/bench_report.h) of a serial capture or a
+native run. Other lines are ignored, so the whole log can be passed as is.
+
+    python3 tools/bench_compare.py csv run.log > run.csv
+    python3 tools/bench_compare.py save run.log baseline.json
+    python3 tools/bench_compare.py compare run.log baseline.json --threshold 5
+
+compare exits with status 1 when a value grew by more than the threshold
+(percent): every metric is a cost, lower is better. It also fails when no
+result matches the baseline, or when baseline results are missing from the
+run (unless --allow-missing), so a gate cannot pass by comparing nothing.
+Results are matched on suite, resolver, path, metric, CPU frequency and
+chip, so device and host runs can share one baseline file. Host results
+leave the CPU frequency out: the host clock is not set by the benchmark.
+A value recorded several times is reduced to its median.
+"""
+
+import argparse
+import csv
+import json
+import statistics
+import sys
+
+PREFIX = 'BENCH '
+KEY_FIELDS = ('suite', 'resolver', 'path', 'metric', 'cpu_mhz', 'chip')
+CSV_FIELDS = KEY_FIELDS + ('value', 'unit', 'iterations', 'revision', 'build')
+NOT_COMPARED = {'ci_low', 'ci_high'}  # Interval bounds, compared through the median
+HOST_CHIP = 'Linux host'  # EspClass::getChipModel() of lib/ArduinoNative
+
+
+def read_records(filename):
+    records = []
+    with open(filename, encoding='utf-8', errors='replace') as log:
+        for line in log:
+            start = line.find(PREFIX)
+            if start < 0:
+                continue
+            try:
+                records.append(json.loads(line[start + len(PREFIX):]))
+            except json.JSONDecodeError:
+                continue  # Line cut by a reset or a full serial buffer
+    return records
+
+
+def key_of(record):
+    host = record.get('chip') == HOST_CHIP
+    return '|'.join('' if host and field == 'cpu_mhz' else str(record.get(field, '')) for field in KEY_FIELDS)
+
+
+def summarize(records):
+    values = {}
+    for record in records:
+        values.setdefault(key_of(record), []).append(record)
+    summary = {}
+    for key, group in values.items():
+        entry = dict(group[-1])
+        finite = [record['value'] for record in group if record['value'] is not None]
+        entry['value'] = statistics.median(finite) if finite else None  # null: not a number on the device
+        summary[key] = entry
+    return summary
+
+
+def command_csv(args):
+    writer = csv.DictWriter(sys.stdout, fieldnames=CSV_FIELDS, extrasaction='ignore')
+    writer.writeheader()
+    for record in read_records(args.log):
+        writer.writerow(record)
+
+
+def command_save(args):
+    summary = summarize(read_records(args.log))
+    if not summary:
+        sys.exit('%s: no BENCH records' % args.log)
+    with open(args.baseline, 'w', encoding='utf-8') as out:
+        json.dump(summary, out, indent=1, sort_keys=True)
+    print('%d results saved to %s' % (len(summary), args.baseline))
+
+
+def command_compare(args):
+    with open(args.baseline, encoding='utf-8') as source:
+        baseline = json.load(source)
+    current = summarize(read_records(args.log))
+
+    regressions = []
+    improvements = 0
+    compared = 0
+    for key, entry in sorted(current.items()):
+        base = baseline.get(key)
+        if base is None or entry['metric'] in NOT_COMPARED or base['value'] is None or entry['value'] is None:
+            continue
+        compared += 1
+        old, new = base['value'], entry['value']
+        limit = old * (1 + args.threshold / 100.0)
+        if new > limit and new - old > args.floor:
+            regressions.append((entry, old, new))
+        elif new < old * (1 - args.threshold / 100.0):
+            improvements += 1
+
+    for entry, old, new in regressions:
+        change = '+%.1f%%' % ((new - old) * 100.0 / old) if old else 'new cost'
+        print('REGRESSION %-10s %-12s %-40s %-22s %12.6g -> %-12.6g %s (%s MHz)' % (
+            entry['suite'], entry['resolver'], entry['path'], entry['metric'], old, new, change, entry['cpu_mhz']))
+    missing = len(set(baseline) - set(current))
+    print('%d results compared, %d regressions, %d improvements beyond %.1f%%, %d baseline results not in this run' % (
+        compared, len(regressions), improvements, args.threshold, missing))
+    if compared == 0:
+        print('ERROR: no result of %s matches %s (other chip, clock or suites?)' % (args.log, args.baseline),
+              file=sys.stderr)
+        return 1
+    if missing and not args.allow_missing:
+        print('ERROR: %d baseline results are missing from this run, pass --allow-missing if that is expected'
+              % missing, file=sys.stderr)
+        return 1
+    return 1 if regressions else 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    commands = parser.add_subparsers(dest='command', required=True)
+
+    extract = commands.add_parser('csv', help='print the records of a log as CSV')
+    extract.add_argument('log')
+    extract.set_defaults(run=command_csv)
+
+    save = commands.add_parser('save', help='store the results of a log as the baseline')
+    save.add_argument('log')
+    save.add_argument('baseline')
+    save.set_defaults(run=command_save)
+
+    compare = commands.add_parser('compare', help='compare the results of a log with the baseline')
+    compare.add_argument('log')
+    compare.add_argument('baseline')
+    compare.add_argument('--threshold', type=float, default=5.0, help='allowed growth in percent (default 5)')
+    compare.add_argument('--floor', type=float, default=0.0,
+                         help='ignore growth smaller than this absolute amount, for values near zero')
+    compare.add_argument('--allow-missing', action='store_true',
+                         help='do not fail when baseline results are absent from the run (partial runs)')
+    compare.set_defaults(run=command_compare)
+
+    args = parser.parse_args()
+    return args.run(args)
+
+
+if __name__ == '__main__':
+    sys.exit(main())
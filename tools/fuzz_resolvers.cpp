@@ -0,0 +1,21 @@
+// libFuzzer target: every registered resolver against the reference on arbitrary paths.
+// Build (a single command line) and run:
+//
+//   clang++ -std=gnu++17 -O1 -g -fsanitize=fuzzer,address -DBENCH_NATIVE -DBENCH_FUZZ
+//       -Ilib/ArduinoNative/src -Iinclude src/*.cpp lib/ArduinoNative/src/*.cpp tools/fuzz_resolvers.cpp
+//       -o fuzz_resolvers -lpthread
+//   ./fuzz_resolvers -max_len=64
+//
+// BENCH_FUZZ drops the host main() of lib/ArduinoNative, setup() and loop() are never called.
+
+#include "differential.h"
+
+#include <stdlib.h>
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+  static DifferentialStats stats;
+  if (checkResolvers((const char *)data, size, stats))
+    abort();
+  return 0;
+}
@@ -0,0 +1,115 @@
+#!/usr/bin/env python3
+"""Convert an HTTP access log into include/access_trace.h.
+
+Accepts Common/Combined Log Format lines ("GET /path HTTP/1.1") or one
+request path per line. Query strings are dropped, as AsyncWebServer does
+when it splits the URL.
+
+    python3 tools/gen_access_trace.py data/access_sample.log include/access_trace.h
+
+With --check nothing is written: the exit status is 1 when the header is
+out of date with the log. PlatformIO runs update() before every build
+through tools/pio_access_trace.py, so the checked in header follows the log.
+"""
+
+import argparse
+import re
+import sys
+
+SOURCE = 'data/access_sample.log'
+TARGET = 'include/access_trace.h'
+
+MAX_PATHS = 64      # WORKLOAD_MAX_PATHS in include/workload.h
+MAX_LENGTH = 4096   # WORKLOAD_MAX_LENGTH in include/workload.h
+
+REQUEST = re.compile(r'"[A-Z]+ (\S+)[^"]*"')
+
+
+def request_path(line):
+    match = REQUEST.search(line)
+    path = match.group(1) if match else line.strip()
+    return path.split('?', 1)[0] if path.startswith('/') else None
+
+
+def c_string(text):
+    return '"' + text.replace('\\', '\\\\').replace('"', '\\"') + '"'
+
+
+def render(source, target):
+    """Text of the header for the log at source"""
+    paths = []
+    sequence = []
+    with open(source, encoding='utf-8', errors='replace') as log:
+        for line in log:
+            path = request_path(line)
+            if path is None:
+                continue
+            if path not in paths:
+                if len(paths) == MAX_PATHS:
+                    continue
+                paths.append(path)
+            sequence.append(paths.index(path))
+            if len(sequence) == MAX_LENGTH:
+                break
+
+    lines = ['#pragma once', '']
+    lines.append('// Generated by tools/gen_access_trace.py from %s, do not edit.' % source)
+    lines.append('// Regenerate: python3 tools/gen_access_trace.py %s %s' % (source, target))
+    lines.append('// (pio run does it before each build), compare only: add --check.')
+    lines += ['', '#include <stdint.h>', '']
+    lines.append('#define ACCESS_TRACE_PATHS %d' % len(paths))
+    lines.append('#define ACCESS_TRACE_LENGTH %d' % len(sequence))
+    lines.append('#define ACCESS_TRACE_PATH_BYTES %d // Sum of the path lengths'
+                 % sum(len(path.encode('utf-8')) for path in paths))
+    lines.append('')
+    lines.append('inline constexpr const char *accessTracePaths[ACCESS_TRACE_PATHS] = {')
+    lines += ['    %s,' % c_string(path) for path in paths]
+    lines += ['};', '']
+    row = 'inline constexpr uint8_t accessTraceSequence[ACCESS_TRACE_LENGTH] = {'
+    for i, index in enumerate(sequence):
+        if i % 24 == 0:
+            lines.append(row)
+            row = '   '
+        row += ' %d,' % index
+    lines += [row, '};']
+    return '\n'.join(lines) + '\n'
+
+
+def current(target):
+    try:
+        with open(target, encoding='utf-8') as header:
+            return header.read()
+    except FileNotFoundError:
+        return None
+
+
+def update(source, target):
+    """Rewrite target when it differs from the log, return True if it did"""
+    text = render(source, target)
+    if current(target) == text:
+        return False
+    with open(target, 'w', encoding='utf-8') as out:
+        out.write(text)
+    return True
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('source', nargs='?', default=SOURCE, help='access log (default %(default)s)')
+    parser.add_argument('target', nargs='?', default=TARGET, help='header to write (default %(default)s)')
+    parser.add_argument('--check', action='store_true', help='only compare, exit status 1 when out of date')
+    args = parser.parse_args()
+
+    if args.check:
+        if current(args.target) != render(args.source, args.target):
+            print('%s is out of date, run: python3 tools/gen_access_trace.py %s %s'
+                  % (args.target, args.source, args.target))
+            return 1
+        print('%s is up to date' % args.target)
+        return 0
+    update(args.source, args.target)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
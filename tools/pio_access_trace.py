@@ -0,0 +1,23 @@
+"""PlatformIO pre-build script: regenerate include/access_trace.h when data/access_sample.log changed.
+
+    extra_scripts = pre:tools/pio_access_trace.py
+"""
+
+import os
+import sys
+
+Import('env')  # noqa: F821 (provided by SCons)
+
+project = env.subst('$PROJECT_DIR')  # noqa: F821
+sys.path.insert(0, os.path.join(project, 'tools'))
+
+import gen_access_trace  # noqa: E402
+
+# Project relative paths, as written in the header comment
+cwd = os.getcwd()
+os.chdir(project)
+try:
+    if gen_access_trace.update(gen_access_trace.SOURCE, gen_access_trace.TARGET):
+        print('Regenerated %s from %s' % (gen_access_trace.TARGET, gen_access_trace.SOURCE))
+finally:
+    os.chdir(cwd)
@@ -0,0 +1,138 @@
+#!/usr/bin/env python3
+"""Code, rodata and static RAM of every resolver, read from the linked ELF.
+
+Runs nm on the firmware (or the native program) and adds up the symbols
+each version owns: its function, the helpers it calls and the tables it
+reads. The versions are the REGISTER_RESOLVER / REGISTER_RESOLVER_FLAGS
+lines of src/*.cpp, in registration order; OWNED adds the tables, state
+and helpers of a version. Sections decide the class: .iram* is IRAM
+code, other .text is flash code, .rodata / .data.rel.ro is rodata,
+.data / .bss / .dram* is static RAM. A symbol counts once per version
+(by address), and a table shared by several versions counts in each.
+
+    python3 tools/resolver_footprint.py .pio/build/lolin_s3_mini/firmware.elf \\
+        --nm ~/.platformio/packages/toolchain-xtensa-esp32s3/bin/xtensa-esp32s3-elf-nm
+    python3 tools/resolver_footprint.py .pio/build/native/program --records
+
+--records prints the results as BENCH lines (see include/bench_report.h)
+so tools/bench_compare.py can store and compare them with the runtime ones.
+"""
+
+import argparse
+import glob
+import json
+import os
+import re
+import subprocess
+import sys
+
+SOURCE_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'src')
+REGISTRATION = re.compile(r'^\s*REGISTER_RESOLVER(?:_FLAGS)?\(\s*(\w+)\s*,\s*"([^"]+)"\s*,\s*(-?\d+)', re.MULTILINE)
+
+# Symbols a version owns besides its function, by function name, as regular expressions over demangled names
+OWNED = {
+    '_setContentTypeFromPath_v4': [r'^mimeHashTable$'],
+    '_setContentTypeFromPath_v5': [r'^packedMimeTable$'],
+    '_setContentTypeFromPath_v6': [r'^probeTable$', r'^stats$', r'^callsUntilReorder$', r'^reorderProbes\('],
+    '_setContentTypeFromPath_v7': [r'^PathCache::', r'^cacheV7$', r'_setContentTypeFromPath_v4\(',
+                                   r'^mimeHashTable$'],
+    '_setContentTypeFromPath_v8': [r'^mimeHashTable$'],
+    '_setContentTypeFromPath_v9': [r'IgnoreCase\(', r'^mimeHashTable$'],
+    '_setContentTypeFromPath_v10': [r'^mimeHashTable$'],
+    '_setContentTypeFromPath_v11': [r'^mimeDfa$'],
+}
+
+# Used by every version that goes through mimeTable, listed apart
+SHARED = [r'^mimeTable$', r'^_contentType$', r'^_contentEncoding$']
+
+CLASSES = ('code_bytes', 'iram_bytes', 'rodata_bytes', 'ram_bytes')
+
+
+def registered_resolvers(source_dir):
+    """(name, symbol patterns) of every registered version, in registration order"""
+    found = []
+    for filename in sorted(glob.glob(os.path.join(source_dir, '*.cpp'))):
+        with open(filename, encoding='utf-8') as source:
+            for match in REGISTRATION.finditer(source.read()):
+                func, name, order = match.groups()
+                found.append((int(order), name, [re.escape(func) + r'\('] + OWNED.get(func, [])))
+    return [(name, patterns) for order, name, patterns in sorted(found)]
+
+
+def section_class(section):
+    if section.startswith('.iram'):
+        return 'iram_bytes'
+    if section.startswith(('.text', '.flash.text')):
+        return 'code_bytes'
+    if section.startswith(('.rodata', '.flash.rodata', '.data.rel.ro')):
+        return 'rodata_bytes'
+    if section.startswith(('.data', '.bss', '.dram', '.noinit', '.sbss', '.sdata')):
+        return 'ram_bytes'
+    return None
+
+
+def read_symbols(nm, elf):
+    """(name, address, size, section) of every sized symbol"""
+    output = subprocess.run([nm, '-C', '-S', '--defined-only', '--format=sysv', elf], check=True,
+                            capture_output=True, text=True).stdout
+    symbols = []
+    for line in output.splitlines():
+        fields = [field.strip() for field in line.split('|')]
+        if len(fields) < 7 or not fields[4]:
+            continue
+        try:
+            symbols.append((fields[0], int(fields[1], 16), int(fields[4], 16), fields[6]))
+        except ValueError:
+            continue
+    return symbols
+
+
+def footprint(symbols, patterns):
+    regexes = [re.compile(pattern) for pattern in patterns]
+    totals = dict.fromkeys(CLASSES, 0)
+    seen = set()
+    for name, address, size, section in symbols:
+        kind = section_class(section)
+        if kind is None or address in seen or not any(regex.search(name) for regex in regexes):
+            continue
+        seen.add(address)
+        totals[kind] += size
+    return totals
+
+
+def record(resolver, metric, value, elf):
+    return 'BENCH ' + json.dumps({
+        'suite': 'footprint', 'resolver': resolver, 'path': '*', 'metric': metric, 'value': value,
+        'unit': 'bytes', 'iterations': 0, 'cpu_mhz': 0, 'chip': '', 'revision': 0, 'build': 'elf ' + elf,
+    }, separators=(',', ':'))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('elf')
+    parser.add_argument('--nm', default='nm', help='nm of the toolchain that built the ELF')
+    parser.add_argument('--records', action='store_true', help='print BENCH records instead of a table')
+    parser.add_argument('--source', default=SOURCE_DIR, help='directory of the REGISTER_RESOLVER lines (default src/)')
+    args = parser.parse_args()
+
+    resolvers = registered_resolvers(args.source)
+    if not resolvers:
+        sys.exit('%s: no REGISTER_RESOLVER lines' % args.source)
+    symbols = read_symbols(args.nm, args.elf)
+    rows = [(name, footprint(symbols, patterns)) for name, patterns in resolvers]
+    rows.append(('shared', footprint(symbols, SHARED)))
+
+    if args.records:
+        for name, totals in rows:
+            for metric in CLASSES:
+                print(record(name, metric, totals[metric], args.elf))
+        return
+
+    print('%-12s %10s %10s %10s %10s' % ('version', 'code', 'IRAM', 'rodata', 'RAM'))
+    for name, totals in rows:
+        print('%-12s %10d %10d %10d %10d' % ((name,) + tuple(totals[metric] for metric in CLASSES)))
+    print('\nString literals (MIME types, v1-v3 extensions) have no symbol and are not attributed.')
+
+
+if __name__ == '__main__':
+    sys.exit(main())